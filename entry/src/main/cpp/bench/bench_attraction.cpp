@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "benchmark.h"
+#include "bench_fixtures.h"
+#include "render/barnes_hut.h"
+
+// Attraction runs past the pool's capacity here: the point is how the two methods scale.
+static const int32_t g_bodyCounts[] = {100, 1000, 4000};
+static const float g_thetas[] = {0.3f, 0.5f, 1.0f};
+
+#define BENCH_ATTRACTION_STRENGTH 1.0e6f
+#define BENCH_SOFTENING 25.0f
+#define BENCH_CROSSOVER_STEP 16
+#define BENCH_CROSSOVER_MAX 512
+#define BENCH_CROSSOVER_REPS 5
+
+struct Bodies {
+    std::vector<float> x, y, mass, ax, ay;
+};
+
+// Uniform over a square with the same density as 100 balls on the wearable panel.
+static Bodies MakeBodies(int32_t count)
+{
+    Bodies bodies;
+    std::mt19937 rng(1234);
+    float side = BENCH_SCENE_WIDTH * std::sqrt(count / 100.0f);
+    std::uniform_real_distribution<float> coord(0.0f, side);
+    std::uniform_real_distribution<float> mass(0.5f, 2.0f);
+    for (int32_t i = 0; i < count; i++) {
+        bodies.x.push_back(coord(rng));
+        bodies.y.push_back(coord(rng));
+        bodies.mass.push_back(mass(rng));
+    }
+    bodies.ax.resize(count);
+    bodies.ay.resize(count);
+    return bodies;
+}
+
+static void Exact(Bodies &b)
+{
+    BarnesHut::ComputeExact(b.x.data(), b.y.data(), b.mass.data(), (int32_t)b.x.size(), BENCH_ATTRACTION_STRENGTH,
+                            BENCH_SOFTENING, b.ax.data(), b.ay.data());
+}
+
+static void BenchExact(BenchState &state, int32_t count)
+{
+    Bodies bodies = MakeBodies(count);
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        Exact(bodies);
+        ClobberMemory();
+    }
+}
+
+// threadCount 1 isolates the algorithmic win; 0 adds the pool on top of it. exactMaxBodies 0 forces
+// the tree even where Compute() would pick the exact sum; -1 measures what Compute() actually does.
+static void BenchBarnesHut(BenchState &state, int32_t count, float theta, int32_t threadCount,
+                           int32_t exactMaxBodies = 0)
+{
+    Bodies bodies = MakeBodies(count);
+    BarnesHut solver(threadCount);
+    solver.SetTheta(theta);
+    solver.SetExactMaxBodies(exactMaxBodies);
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        solver.Compute(bodies.x.data(), bodies.y.data(), bodies.mass.data(), count, BENCH_ATTRACTION_STRENGTH,
+                       BENCH_SOFTENING, bodies.ax.data(), bodies.ay.data());
+        ClobberMemory();
+    }
+    state.StopTimer();
+
+    // RMS error relative to the RMS exact force.
+    Bodies exact = bodies;
+    Exact(exact);
+    double errorSquared = 0.0;
+    double forceSquared = 0.0;
+    for (int32_t i = 0; i < count; i++) {
+        double dx = bodies.ax[i] - exact.ax[i];
+        double dy = bodies.ay[i] - exact.ay[i];
+        errorSquared += dx * dx + dy * dy;
+        forceSquared += (double)exact.ax[i] * exact.ax[i] + (double)exact.ay[i] * exact.ay[i];
+    }
+    state.SetCounter("rms_err_pct", 100.0 * std::sqrt(errorSquared / forceSquared));
+    state.SetCounter("nodes", solver.NodeCount());
+}
+
+// Best of a few runs, so one preempted run does not move the crossover.
+static int64_t BestOfNs(const std::function<void()> &run)
+{
+    int64_t best = INT64_MAX;
+    for (int32_t rep = 0; rep < BENCH_CROSSOVER_REPS; rep++) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        ClobberMemory();
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                         .count();
+        best = std::min(best, ns);
+    }
+    return best;
+}
+
+// Times exact against the single-threaded tree from BENCH_CROSSOVER_STEP bodies upward and reports
+// the first count where the tree wins, next to the BarnesHut::ExactMaxBodies table value Compute()
+// switches at. The sample time is the whole scan.
+static void BenchCrossover(BenchState &state, float theta)
+{
+    BarnesHut solver(1);
+    solver.SetTheta(theta);
+    solver.SetExactMaxBodies(0);
+    int32_t crossover = 0;
+    double exactAtCrossover = 0.0;
+    double treeAtCrossover = 0.0;
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        crossover = 0;
+        for (int32_t count = BENCH_CROSSOVER_STEP; count <= BENCH_CROSSOVER_MAX; count += BENCH_CROSSOVER_STEP) {
+            Bodies bodies = MakeBodies(count);
+            int64_t exactNs = BestOfNs([&] { Exact(bodies); });
+            int64_t treeNs = BestOfNs([&] {
+                solver.Compute(bodies.x.data(), bodies.y.data(), bodies.mass.data(), count, BENCH_ATTRACTION_STRENGTH,
+                               BENCH_SOFTENING, bodies.ax.data(), bodies.ay.data());
+            });
+            if (treeNs < exactNs) {
+                crossover = count;
+                exactAtCrossover = (double)exactNs;
+                treeAtCrossover = (double)treeNs;
+                break;
+            }
+        }
+    }
+    state.StopTimer();
+    // 0: the tree never won up to BENCH_CROSSOVER_MAX bodies.
+    state.SetCounter("crossover_bodies", crossover);
+    state.SetCounter("exact_ns", exactAtCrossover);
+    state.SetCounter("tree_ns", treeAtCrossover);
+    state.SetCounter("exact_max_bodies", BarnesHut::ExactMaxBodies(theta));
+}
+
+static int RegisterAttractionBenchmarks()
+{
+    for (float theta : g_thetas) {
+        std::string name = "attraction/crossover/theta:" + std::to_string(theta).substr(0, 3);
+        RegisterBenchmark(name.c_str(), [theta](BenchState &state) { BenchCrossover(state, theta); });
+    }
+    for (int32_t count : g_bodyCounts) {
+        std::string bodies = std::to_string(count);
+        RegisterBenchmark(("attraction/exact/" + bodies).c_str(),
+                          [count](BenchState &state) { BenchExact(state, count); });
+        for (float theta : g_thetas) {
+            std::string name = "attraction/barnes_hut/" + bodies + "/theta:" + std::to_string(theta).substr(0, 3);
+            RegisterBenchmark((name + "/threads:1").c_str(),
+                              [count, theta](BenchState &state) { BenchBarnesHut(state, count, theta, 1); });
+        }
+        RegisterBenchmark(("attraction/barnes_hut/" + bodies + "/theta:0.5/threads:all").c_str(),
+                          [count](BenchState &state) { BenchBarnesHut(state, count, BH_DEFAULT_THETA, 0); });
+        RegisterBenchmark(("attraction/compute/" + bodies + "/theta:0.5").c_str(),
+                          [count](BenchState &state) { BenchBarnesHut(state, count, BH_DEFAULT_THETA, 0, -1); });
+    }
+    return 0;
+}
+static int g_attractionRegistered = RegisterAttractionBenchmarks();
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+#include "benchmark.h"
+#include "bench_fixtures.h"
+#include "render/block_culler.h"
+#include "render/metaball_scene.h"
+#include "render/soft_core.h"
+
+static const int32_t g_cullDensities[] = {5, 20, 50, 100};
+
+static void BenchBlockClassify(BenchState &state, int32_t count)
+{
+    SeedScene(count);
+    BlockCuller culler;
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        culler.Classify(g_metaballPositions, g_metaballWeights, count, IsoLevels(), BENCH_SCENE_WIDTH,
+                        BENCH_SCENE_HEIGHT);
+        ClobberMemory();
+    }
+    state.SetCounter("skipped_pct", 100.0 * culler.SkippedFraction());
+}
+
+// Single-threaded so the pair of entries per density isolates the per-pixel work that culling removes.
+static void BenchCulledRender(BenchState &state, int32_t count, bool culling)
+{
+    SeedScene(count);
+    SoftCore core(1);
+    core.SetBlockCulling(culling);
+    std::vector<uint32_t> pixels((size_t)BENCH_SCENE_WIDTH * BENCH_SCENE_HEIGHT);
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        core.RenderToBuffer(g_metaballPositions, g_metaballWeights, g_metaballColors, count, pixels.data(),
+                            BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT, BENCH_SCENE_WIDTH * (int32_t)sizeof(uint32_t));
+        ClobberMemory();
+    }
+    state.SetCounter("skipped_pct", 100.0 * core.SkippedFraction());
+}
+
+static int RegisterCullingBenchmarks()
+{
+    for (int32_t count : g_cullDensities) {
+        std::string balls = std::to_string(count);
+        RegisterBenchmark(("block_culler/classify/" + balls).c_str(),
+                          [count](BenchState &state) { BenchBlockClassify(state, count); });
+        RegisterBenchmark(("block_culler/render_466/" + balls + "/full").c_str(),
+                          [count](BenchState &state) { BenchCulledRender(state, count, false); });
+        RegisterBenchmark(("block_culler/render_466/" + balls + "/culled").c_str(),
+                          [count](BenchState &state) { BenchCulledRender(state, count, true); });
+    }
+    return 0;
+}
+static int g_cullingRegistered = RegisterCullingBenchmarks();
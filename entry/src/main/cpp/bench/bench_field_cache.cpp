@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <GLES3/gl3.h>
+#include "benchmark.h"
+#include "bench_fixtures.h"
+#include "render/egl_core_shader.h"
+#include "render/field_cache.h"
+#include "render/metaball_scene.h"
+
+#define BENCH_FRAME_NS 16666667LL
+
+// Full 466x466 GLES frames of MAX_METABALLS balls where only `moved` of them are dragged each frame.
+// The clock never advances, so the simulation leaves the rest in place. moved == 0 is the direct
+// shader with the cache off, the cost the cache has to beat; the crossover in moved balls is where
+// FIELD_UPDATE_COST comes from. Reports "unavailable" without pbuffers or a blendable R32F target.
+static void BenchFieldCacheFrame(BenchState &state, int32_t moved)
+{
+    std::string id("bench");
+    EGLCore core(id);
+    if (!InitOffscreenCore(core, SurfaceRequest(), BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT)) {
+        state.SetCounter("unavailable", 1);
+        return;
+    }
+    core.SetBlockCulling(false);
+    core.SetIncrementalField(moved > 0);
+    SeedScene(MAX_METABALLS);
+    // The first frame starts the clock and creates the cache, the second builds it.
+    core.RenderLoop(BENCH_FRAME_NS);
+    core.RenderLoop(BENCH_FRAME_NS);
+    glFinish();
+    if (moved > 0 && !core.fieldCache_) {
+        state.SetCounter("unavailable", 1);
+        ReleaseOffscreenCore(core);
+        return;
+    }
+    float offset = 0.0f;
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        offset = offset > 0.0f ? -1.0f : 1.0f;
+        for (int32_t ball = 0; ball < moved; ball++) {
+            const float *position = &g_metaballPositions[2 * ball];
+            core.MoveMetaball(g_metaballs.HandleAt(ball), position[0] + offset, position[1]);
+        }
+        core.RenderLoop(BENCH_FRAME_NS);
+        glFinish();
+    }
+    state.StopTimer();
+
+    state.SetCounter("moved", moved);
+    state.SetCounter("cache_updated", core.fieldCache_ ? core.fieldCache_->LastUpdatedBalls() : 0);
+    ReleaseOffscreenCore(core);
+}
+
+static int RegisterFieldCacheBenchmarks()
+{
+    RegisterBenchmark("field_cache/direct_466", [](BenchState &state) { BenchFieldCacheFrame(state, 0); });
+    for (int32_t moved : {1, 4, 16, 25}) {
+        std::string name = "field_cache/frame_466/moved_" + std::to_string(moved);
+        RegisterBenchmark(name.c_str(), [moved](BenchState &state) { BenchFieldCacheFrame(state, moved); });
+    }
+    return 0;
+}
+static int g_fieldCacheRegistered = RegisterFieldCacheBenchmarks();
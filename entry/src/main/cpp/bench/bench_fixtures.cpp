@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench_fixtures.h"
+#include "render/metaball_scene.h"
+
+#define BENCH_RNG_SEED 1234u
+
+#ifndef EGL_GL_COLORSPACE_KHR
+#define EGL_GL_COLORSPACE_KHR 0x309D
+#endif
+
+#ifndef EGL_GL_COLORSPACE_SRGB_KHR
+#define EGL_GL_COLORSPACE_SRGB_KHR 0x3089
+#endif
+
+void SeedScene(int32_t count)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_metaballMutex);
+        g_metaballs.Clear();
+        // Fixed seed so every run measures the same headings and bounces.
+        g_rng.seed(BENCH_RNG_SEED);
+    }
+    for (int32_t i = 0; i < count; i++) {
+        float x = (float)((i * 97) % BENCH_SCENE_WIDTH);
+        float y = (float)((i * 61 + 23) % BENCH_SCENE_HEIGHT);
+        AddMetaball(x, y, (float)BENCH_SCENE_WIDTH, (float)BENCH_SCENE_HEIGHT, METABALL_DEFAULT_RADIUS);
+    }
+    std::lock_guard<std::mutex> lock(g_metaballMutex);
+    PackMetaballPositions(1.0f);
+}
+
+bool InitOffscreenCore(EGLCore &core, const SurfaceRequest &request, int32_t w, int32_t h)
+{
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+        return false;
+    }
+    core.width_ = w;
+    core.height_ = h;
+    core.mEGLDisplay = display;
+    core.mEGLConfig = ChooseSurfaceConfig(display, EGL_PBUFFER_BIT, request, core.surfaceFormat_);
+    if (!core.mEGLConfig) {
+        return false;
+    }
+
+    bool srgb = request.srgb && core.surfaceFormat_.red == 8;
+    EGLint srgbAttribs[] = {EGL_WIDTH, w, EGL_HEIGHT, h, EGL_GL_COLORSPACE_KHR, EGL_GL_COLORSPACE_SRGB_KHR, EGL_NONE};
+    EGLint linearAttribs[] = {EGL_WIDTH, w, EGL_HEIGHT, h, EGL_NONE};
+    core.mEGLSurface = srgb ? eglCreatePbufferSurface(display, core.mEGLConfig, srgbAttribs) : EGL_NO_SURFACE;
+    if (core.mEGLSurface == EGL_NO_SURFACE) {
+        srgb = false;
+        core.mEGLSurface = eglCreatePbufferSurface(display, core.mEGLConfig, linearAttribs);
+    }
+    core.surfaceFormat_.srgb = srgb;
+    EGLint contextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
+    core.mEGLContext = eglCreateContext(display, core.mEGLConfig, EGL_NO_CONTEXT, contextAttribs);
+    if (core.mEGLSurface == EGL_NO_SURFACE || core.mEGLContext == EGL_NO_CONTEXT ||
+        !eglMakeCurrent(display, core.mEGLSurface, core.mEGLSurface, core.mEGLContext) || !core.InitGL()) {
+        ReleaseOffscreenCore(core);
+        return false;
+    }
+    return true;
+}
+
+void ReleaseOffscreenCore(EGLCore &core)
+{
+    core.OnSurfaceDestroyed();
+    eglMakeCurrent(core.mEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
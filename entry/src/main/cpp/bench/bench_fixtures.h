@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_FIXTURES_H
+#define BENCH_FIXTURES_H
+
+#include <cstdint>
+#include "render/egl_core_shader.h"
+#include "render/surface_format.h"
+
+// Round wearable panel, the size the app is tuned for.
+#define BENCH_SCENE_WIDTH 466
+#define BENCH_SCENE_HEIGHT 466
+
+// Replaces the shared scene with count balls at fixed positions and headings.
+void SeedScene(int32_t count);
+
+// Brings core up on an offscreen ES3 pbuffer of the requested format, sRGB when the format allows it,
+// the way OnSurfaceCreated would for a window. Needs an EGL driver with pbuffer configs (Mesa's
+// surfaceless platform works); false, with nothing left to release, if there is none.
+bool InitOffscreenCore(EGLCore &core, const SurfaceRequest &request, int32_t w, int32_t h);
+void ReleaseOffscreenCore(EGLCore &core);
+
+#endif // BENCH_FIXTURES_H
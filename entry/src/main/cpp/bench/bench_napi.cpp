@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include "benchmark.h"
+#include "bench_fixtures.h"
+#include "render/event_channel.h"
+#include "render/metaball_scene.h"
+#include "render/plugin_render.h"
+#include "stubs/napi_stub_env.h"
+
+// The JS-facing entry points, including argument unwrapping, through the in-process NAPI stub.
+static void BenchNapiAddMetaball(BenchState &state)
+{
+    SeedScene(0);
+    napi_callback_info info =
+        NapiStub::CallInfo({NapiStub::Context(), NapiStub::Number(120.0), NapiStub::Number(240.0)});
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        if (g_metaballs.Full()) {
+            std::lock_guard<std::mutex> lock(g_metaballMutex);
+            g_metaballs.Clear();
+        }
+        napi_value result = PluginRender::NapiAddMetaball(NapiStub::Env(), info);
+        DoNotOptimize(result);
+    }
+}
+BENCHMARK("napi/add_metaball", BenchNapiAddMetaball);
+
+static void BenchNapiMoveMetaball(BenchState &state)
+{
+    SeedScene(MAX_METABALLS);
+    napi_value handle = NapiStub::Number((double)g_metaballs.HandleAt(MAX_METABALLS / 2));
+    napi_callback_info info =
+        NapiStub::CallInfo({NapiStub::Context(), handle, NapiStub::Number(50.0), NapiStub::Number(60.0)});
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        napi_value result = PluginRender::NapiMoveMetaball(NapiStub::Env(), info);
+        DoNotOptimize(result);
+    }
+}
+BENCHMARK("napi/move_metaball", BenchNapiMoveMetaball);
+
+// Per-frame event cost on the render thread with one all-events subscriber; the stub delivers synchronously.
+static void BenchEventsFrame(BenchState &state)
+{
+    napi_threadsafe_function tsfn = nullptr;
+    napi_create_threadsafe_function(NapiStub::Env(), nullptr, nullptr, nullptr, 0, 1, nullptr, nullptr, nullptr,
+                                    EventChannel::CallJs, &tsfn);
+    uint32_t subscription = g_renderEvents.Subscribe(RENDER_EVENT_ALL, tsfn);
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        g_renderEvents.PostBallCount((int32_t)(i & 63));
+        g_renderEvents.PostFrame(16.7, 2.0, 2);
+        g_renderEvents.Flush();
+    }
+    g_renderEvents.Unsubscribe(subscription);
+}
+BENCHMARK("events/frame_post_flush", BenchEventsFrame);
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchmark.h"
+#include "bench_fixtures.h"
+#include "render/field_query.h"
+#include "render/metaball_scene.h"
+#include "render/soft_core.h"
+
+#define BENCH_QUERY_POINTS 256
+
+static void BenchFieldIndexPublish(BenchState &state)
+{
+    SeedScene(MAX_METABALLS);
+    FieldIndex index;
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        index.Publish(g_metaballPositions, g_metaballWeights, MAX_METABALLS, IsoLevels());
+        ClobberMemory();
+    }
+}
+BENCHMARK("field_index/publish/100", BenchFieldIndexPublish);
+
+static void BenchFieldIndexHitTest(BenchState &state)
+{
+    SeedScene(MAX_METABALLS);
+    FieldIndex index;
+    index.Publish(g_metaballPositions, g_metaballWeights, MAX_METABALLS, IsoLevels());
+    float points[2 * BENCH_QUERY_POINTS];
+    uint8_t levels[BENCH_QUERY_POINTS];
+    for (int32_t i = 0; i < BENCH_QUERY_POINTS; i++) {
+        points[2 * i] = (float)((i * 37) % BENCH_SCENE_WIDTH);
+        points[2 * i + 1] = (float)((i * 53) % BENCH_SCENE_HEIGHT);
+    }
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        index.HitTest(points, BENCH_QUERY_POINTS, levels);
+        ClobberMemory();
+    }
+    state.SetCounter("points", BENCH_QUERY_POINTS);
+}
+BENCHMARK("field_index/hit_test/256", BenchFieldIndexHitTest);
+
+// The baseline FieldIndex has to beat: every point sums every ball straight out of the packed frame arrays.
+static void BenchFieldBruteForce(BenchState &state)
+{
+    SeedScene(MAX_METABALLS);
+    IsoLevels isoLevels;
+    float points[2 * BENCH_QUERY_POINTS];
+    uint8_t levels[BENCH_QUERY_POINTS];
+    for (int32_t i = 0; i < BENCH_QUERY_POINTS; i++) {
+        points[2 * i] = (float)((i * 37) % BENCH_SCENE_WIDTH);
+        points[2 * i + 1] = (float)((i * 53) % BENCH_SCENE_HEIGHT);
+    }
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        for (int32_t p = 0; p < BENCH_QUERY_POINTS; p++) {
+            float sum = 0.0f;
+            for (int32_t b = 0; b < MAX_METABALLS; b++) {
+                float dx = g_metaballPositions[2 * b] - points[2 * p];
+                float dy = g_metaballPositions[2 * b + 1] - points[2 * p + 1];
+                sum += g_metaballWeights[b] / std::max(dx * dx + dy * dy, 0.001f);
+            }
+            levels[p] = sum >= isoLevels.inside ? FIELD_LEVEL_INSIDE
+                                                : (sum >= isoLevels.halo ? FIELD_LEVEL_HALO : FIELD_LEVEL_OUTSIDE);
+        }
+        DoNotOptimize(levels);
+        ClobberMemory();
+    }
+    state.SetCounter("points", BENCH_QUERY_POINTS);
+}
+BENCHMARK("field_index/brute_force/256", BenchFieldBruteForce);
+
+// Whole-frame software render; one entry per worker count shows how the tile pool scales.
+static void BenchSoftRender(BenchState &state, int32_t threadCount)
+{
+    SeedScene(MAX_METABALLS);
+    SoftCore core(threadCount);
+    std::vector<uint32_t> pixels((size_t)BENCH_SCENE_WIDTH * BENCH_SCENE_HEIGHT);
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        core.RenderToBuffer(g_metaballPositions, g_metaballWeights, g_metaballColors, MAX_METABALLS, pixels.data(),
+                            BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT, BENCH_SCENE_WIDTH * (int32_t)sizeof(uint32_t));
+        ClobberMemory();
+    }
+    state.SetCounter("threads", core.ThreadCount());
+}
+
+// Single-threaded; every other ball tinted, which sends every non-outside block through the SIMD SumFieldTinted.
+static void BenchSoftRenderTinted(BenchState &state)
+{
+    SeedScene(MAX_METABALLS);
+    for (int32_t i = 0; i < MAX_METABALLS; i += 2) {
+        g_metaballColors[i] = 0xFF4080FFu;
+    }
+    SoftCore core(1);
+    std::vector<uint32_t> pixels((size_t)BENCH_SCENE_WIDTH * BENCH_SCENE_HEIGHT);
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        core.RenderToBuffer(g_metaballPositions, g_metaballWeights, g_metaballColors, MAX_METABALLS, pixels.data(),
+                            BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT, BENCH_SCENE_WIDTH * (int32_t)sizeof(uint32_t));
+        ClobberMemory();
+    }
+}
+BENCHMARK("soft_core/render_466_tinted/threads:1", BenchSoftRenderTinted);
+
+static int RegisterSoftRenderBenchmarks()
+{
+    int32_t maxThreads = (int32_t)std::thread::hardware_concurrency();
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+    // 1, 2, 4, ... and always the full core count last.
+    for (int32_t threads = 1;; threads *= 2) {
+        if (threads > maxThreads) {
+            threads = maxThreads;
+        }
+        std::string name = "soft_core/render_466/threads:" + std::to_string(threads);
+        RegisterBenchmark(name.c_str(), [threads](BenchState &state) { BenchSoftRender(state, threads); });
+        if (threads == maxThreads) {
+            break;
+        }
+    }
+    return 0;
+}
+static int g_softRenderRegistered = RegisterSoftRenderBenchmarks();
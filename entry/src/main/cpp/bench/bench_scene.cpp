@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <unistd.h>
+#include "benchmark.h"
+#include "bench_fixtures.h"
+#include "render/metaball_scene.h"
+#include "render/scene_snapshot.h"
+#include "render/sim_clock.h"
+#include "render/timeline.h"
+
+#define BENCH_FRAME_NS 16666667LL
+#define BENCH_SNAPSHOT_PATH "/tmp/metaballs_bench.snapshot"
+
+// Add then remove one ball in a half-full pool: the O(1) slot and swap-remove path.
+static void BenchPoolAddRemove(BenchState &state)
+{
+    MetaballPool pool;
+    Metaball ball = {10.0f, 20.0f, 10.0f, 20.0f, 1.0f, 0.0f, METABALL_DEFAULT_RADIUS};
+    for (int32_t i = 0; i < MAX_METABALLS / 2; i++) {
+        pool.Add(ball);
+    }
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        MetaballHandle handle = pool.Add(ball);
+        DoNotOptimize(handle);
+        pool.Remove(handle);
+    }
+}
+BENCHMARK("pool/add_remove", BenchPoolAddRemove);
+
+static void BenchPoolGet(BenchState &state)
+{
+    MetaballPool pool;
+    Metaball ball = {10.0f, 20.0f, 10.0f, 20.0f, 1.0f, 0.0f, METABALL_DEFAULT_RADIUS};
+    MetaballHandle handles[MAX_METABALLS];
+    for (int32_t i = 0; i < MAX_METABALLS; i++) {
+        handles[i] = pool.Add(ball);
+    }
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        Metaball *mb = pool.Get(handles[i % MAX_METABALLS]);
+        DoNotOptimize(mb);
+    }
+}
+BENCHMARK("pool/get", BenchPoolGet);
+
+// Full public add path: lock, RNG heading, pool insert. Cleared every time the pool fills.
+static void BenchAddMetaball(BenchState &state)
+{
+    SeedScene(0);
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        if (g_metaballs.Full()) {
+            std::lock_guard<std::mutex> lock(g_metaballMutex);
+            g_metaballs.Clear();
+        }
+        MetaballHandle handle = AddMetaball(100.0f, 200.0f, (float)BENCH_SCENE_WIDTH, (float)BENCH_SCENE_HEIGHT,
+                                            METABALL_DEFAULT_RADIUS);
+        DoNotOptimize(handle);
+    }
+}
+BENCHMARK("scene/add_metaball", BenchAddMetaball);
+
+static void BenchUpdateMetaballs(BenchState &state, int32_t count)
+{
+    SeedScene(count);
+    SimClock clock;
+    float speed = METABALL_SPEED_PX_PER_SECOND * clock.StepSeconds();
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        UpdateMetaballs((float)BENCH_SCENE_WIDTH, (float)BENCH_SCENE_HEIGHT, speed);
+        ClobberMemory();
+    }
+}
+BENCHMARK("scene/update_metaballs/10", [](BenchState &state) { BenchUpdateMetaballs(state, 10); });
+BENCHMARK("scene/update_metaballs/100", [](BenchState &state) { BenchUpdateMetaballs(state, 100); });
+
+static void BenchPackPositions(BenchState &state)
+{
+    SeedScene(MAX_METABALLS);
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        PackMetaballPositions(0.5f);
+        ClobberMemory();
+    }
+}
+BENCHMARK("scene/pack_positions/100", BenchPackPositions);
+
+// Everything the GL path adds per frame for per-ball style: the interleaved metaballArray and the tint check.
+static void BenchPackUniforms(BenchState &state)
+{
+    SeedScene(MAX_METABALLS);
+    uint32_t uniforms[4 * MAX_METABALLS];
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        PackMetaballUniforms(uniforms, MAX_METABALLS);
+        bool tinted = MetaballsTinted(MAX_METABALLS);
+        DoNotOptimize(tinted);
+        ClobberMemory();
+    }
+}
+BENCHMARK("scene/pack_uniforms/100", BenchPackUniforms);
+
+// The per-frame simulation work RenderLoop does under the lock at 60 Hz: two fixed steps plus the pack.
+static void BenchSimulationFrame(BenchState &state)
+{
+    SeedScene(MAX_METABALLS);
+    SimClock clock;
+    float speed = METABALL_SPEED_PX_PER_SECOND * clock.StepSeconds();
+    int64_t timestamp = 0;
+    clock.Advance(timestamp);
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        timestamp += BENCH_FRAME_NS;
+        std::lock_guard<std::mutex> lock(g_metaballMutex);
+        int32_t steps = clock.Advance(timestamp);
+        for (int32_t s = 0; s < steps; s++) {
+            UpdateMetaballs((float)BENCH_SCENE_WIDTH, (float)BENCH_SCENE_HEIGHT, speed);
+        }
+        PackMetaballPositions(clock.Alpha());
+        ClobberMemory();
+    }
+}
+BENCHMARK("scene/simulation_frame/100", BenchSimulationFrame);
+
+// One timeline frame for 100 tracks of 8 keys each, cycling so Seek crosses segment boundaries.
+static void BenchTimelineApply(BenchState &state)
+{
+    SeedScene(MAX_METABALLS);
+    const int32_t keysPerTrack = 8;
+    MetaballHandle handles[MAX_METABALLS];
+    std::vector<float> keys;
+    for (int32_t t = 0; t < MAX_METABALLS; t++) {
+        handles[t] = g_metaballs.HandleAt(t);
+        for (int32_t k = 0; k < keysPerTrack; k++) {
+            float key[TIMELINE_KEYFRAME_FLOATS] = {(float)t, 0.5f * k, 50.0f + 40.0f * k, 50.0f + 3.0f * t,
+                                                   METABALL_DEFAULT_RADIUS, (float)(k % (EASE_STEP + 1))};
+            keys.insert(keys.end(), key, key + TIMELINE_KEYFRAME_FLOATS);
+        }
+    }
+    Timeline timeline;
+    timeline.Load(handles, MAX_METABALLS, keys.data(), MAX_METABALLS * keysPerTrack, true);
+    int64_t timestamp = 0;
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        timestamp += BENCH_FRAME_NS;
+        std::lock_guard<std::mutex> lock(g_metaballMutex);
+        timeline.Apply(timestamp, g_metaballs);
+        ClobberMemory();
+    }
+}
+BENCHMARK("timeline/apply/100", BenchTimelineApply);
+
+// A full save: header, CRC, temp file write, both fsyncs and the rename. Dominated by the storage device.
+static void BenchSnapshotSave(BenchState &state)
+{
+    SeedScene(MAX_METABALLS);
+    bool ok = true;
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        ok = SaveSceneSnapshot(BENCH_SNAPSHOT_PATH) && ok;
+    }
+    state.StopTimer();
+    state.SetCounter("failed", ok ? 0 : 1);
+    unlink(BENCH_SNAPSHOT_PATH);
+}
+BENCHMARK("scene/save/100", BenchSnapshotSave);
+
+// A full load from the page cache: mmap, CRC, pool and ball validation, restore.
+static void BenchSnapshotLoad(BenchState &state)
+{
+    SeedScene(MAX_METABALLS);
+    bool ok = SaveSceneSnapshot(BENCH_SNAPSHOT_PATH);
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        ok = LoadSceneSnapshot(BENCH_SNAPSHOT_PATH) && ok;
+    }
+    state.StopTimer();
+    state.SetCounter("failed", ok && g_metaballs.Size() == MAX_METABALLS ? 0 : 1);
+    unlink(BENCH_SNAPSHOT_PATH);
+}
+BENCHMARK("scene/load/100", BenchSnapshotLoad);
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+#include <GLES3/gl3.h>
+#include "benchmark.h"
+#include "bench_fixtures.h"
+#include "render/egl_core_shader.h"
+#include "render/metaball_scene.h"
+#include "render/surface_format.h"
+
+#define BENCH_FRAME_NS 16666667LL
+#define BENCH_REFRESH_HZ 60
+
+// A driver-like config list: four layouts, each with depth, stencil and MSAA variants.
+static void BenchChooseConfig(BenchState &state)
+{
+    const int32_t layouts[][4] = {{5, 6, 5, 0}, {8, 8, 8, 0}, {8, 8, 8, 8}, {10, 10, 10, 2}};
+    std::vector<SurfaceConfigInfo> infos;
+    for (const int32_t *bits : layouts) {
+        for (int32_t depth : {0, 16, 24}) {
+            for (int32_t stencil : {0, 8}) {
+                for (int32_t samples : {0, 4}) {
+                    infos.push_back({bits[0], bits[1], bits[2], bits[3], depth, stencil, samples, false});
+                }
+            }
+        }
+    }
+    SurfaceRequest request;
+    request.profile = SURFACE_RGB565;
+    request.samples = 4;
+    int32_t step = 0;
+    int32_t picked = 0;
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        picked += PickSurfaceConfig(infos.data(), (int32_t)infos.size(), request, step);
+        ClobberMemory();
+    }
+    DoNotOptimize(picked);
+    state.SetCounter("configs", (double)infos.size());
+}
+BENCHMARK("surface/choose_config/48", BenchChooseConfig);
+
+// Full GLES frames into a pbuffer of each format, next to the estimated color traffic of that format.
+// Needs an EGL driver with ES3 pbuffer configs (Mesa's surfaceless platform works); reports
+// "unavailable" otherwise. 8-bit targets get the sRGB colorspace as the window would, 565 the shader encode.
+static void BenchSurfaceFrame(BenchState &state, SurfaceProfile profile, int32_t samples)
+{
+    std::string id("bench");
+    EGLCore core(id);
+    SurfaceRequest request;
+    request.profile = profile;
+    request.samples = samples;
+    if (!InitOffscreenCore(core, request, BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT)) {
+        state.SetCounter("unavailable", 1);
+        return;
+    }
+
+    SeedScene(MAX_METABALLS);
+    // The first frame only starts the clock and warms the shader up.
+    long long timestamp = BENCH_FRAME_NS;
+    core.RenderLoop(timestamp);
+    glFinish();
+    state.ResetTimer();
+    for (uint64_t i = 0; i < state.iterations; i++) {
+        timestamp += BENCH_FRAME_NS;
+        core.RenderLoop(timestamp);
+        glFinish();
+    }
+    state.StopTimer();
+
+    const SurfaceFormat &format = core.surfaceFormat_;
+    int64_t frameBytes = EstimateFrameBytes(format, BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT);
+    state.SetCounter("bits", format.red + format.green + format.blue + format.alpha);
+    state.SetCounter("samples", format.samples);
+    state.SetCounter("fallback_step", format.fallbackStep);
+    state.SetCounter("bytes_per_frame", (double)frameBytes);
+    state.SetCounter("mb_per_s_60hz", (double)frameBytes * BENCH_REFRESH_HZ / 1e6);
+    ReleaseOffscreenCore(core);
+}
+
+static int RegisterSurfaceBenchmarks()
+{
+    const SurfaceProfile profiles[] = {SURFACE_RGBA8888, SURFACE_RGB888, SURFACE_RGB565};
+    for (SurfaceProfile profile : profiles) {
+        for (int32_t samples : {0, 4}) {
+            std::string name = std::string("surface/frame_466/") + SurfaceProfileName(profile);
+            if (samples > 0) {
+                name += "_msaa" + std::to_string(samples);
+            }
+            RegisterBenchmark(name.c_str(),
+                              [profile, samples](BenchState &state) { BenchSurfaceFrame(state, profile, samples); });
+        }
+    }
+    return 0;
+}
+static int g_surfaceRegistered = RegisterSurfaceBenchmarks();
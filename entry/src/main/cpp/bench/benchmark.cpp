@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#define BENCH_MIN_SAMPLE_NS 5000000LL
+#define BENCH_SAMPLES 15
+#define BENCH_MAX_ITERATIONS (1ULL << 30)
+#define BENCH_DEFAULT_THRESHOLD_PERCENT 10.0
+
+struct BenchEntry {
+    std::string name;
+    BenchFunction function;
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations;
+    double minNs;
+    double medianNs;
+    double meanNs;
+    double stddevNs;
+    double maxNs;
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+static std::vector<BenchEntry> &Registry()
+{
+    static std::vector<BenchEntry> registry;
+    return registry;
+}
+
+static int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int RegisterBenchmark(const char *name, BenchFunction function)
+{
+    Registry().push_back({name, std::move(function)});
+    return 0;
+}
+
+void BenchState::ResetTimer()
+{
+    startNs_ = NowNs();
+}
+
+void BenchState::StopTimer()
+{
+    stopNs_ = NowNs();
+}
+
+void BenchState::SetCounter(const std::string &name, double value)
+{
+    for (auto &counter : counters_) {
+        if (counter.first == name) {
+            counter.second = value;
+            return;
+        }
+    }
+    counters_.emplace_back(name, value);
+}
+
+class BenchRunner {
+public:
+    static int64_t Sample(const BenchEntry &entry, uint64_t iterations,
+                          std::vector<std::pair<std::string, double>> &counters)
+    {
+        BenchState state(iterations);
+        state.startNs_ = NowNs();
+        entry.function(state);
+        int64_t elapsed = (state.stopNs_ ? state.stopNs_ : NowNs()) - state.startNs_;
+        counters = std::move(state.counters_);
+        return elapsed;
+    }
+
+    static BenchResult Run(const BenchEntry &entry)
+    {
+        std::vector<std::pair<std::string, double>> counters;
+        uint64_t iterations = 1;
+        // Grow the batch until a sample is long enough for the clock to resolve.
+        for (;;) {
+            int64_t elapsed = Sample(entry, iterations, counters);
+            if (elapsed >= BENCH_MIN_SAMPLE_NS || iterations >= BENCH_MAX_ITERATIONS) {
+                break;
+            }
+            double scale = elapsed > 0 ? (double)BENCH_MIN_SAMPLE_NS * 1.4 / (double)elapsed : 10.0;
+            scale = std::min(std::max(scale, 1.5), 10.0);
+            iterations = std::min((uint64_t)((double)iterations * scale) + 1, (uint64_t)BENCH_MAX_ITERATIONS);
+        }
+
+        std::vector<double> perOp;
+        for (int32_t i = 0; i < BENCH_SAMPLES; i++) {
+            perOp.push_back((double)Sample(entry, iterations, counters) / (double)iterations);
+        }
+        std::sort(perOp.begin(), perOp.end());
+
+        BenchResult result;
+        result.name = entry.name;
+        result.iterations = iterations;
+        result.minNs = perOp.front();
+        result.maxNs = perOp.back();
+        result.medianNs = perOp[perOp.size() / 2];
+        double sum = 0.0;
+        for (double v : perOp) {
+            sum += v;
+        }
+        result.meanNs = sum / (double)perOp.size();
+        double variance = 0.0;
+        for (double v : perOp) {
+            variance += (v - result.meanNs) * (v - result.meanNs);
+        }
+        result.stddevNs = std::sqrt(variance / (double)perOp.size());
+        result.counters = counters;
+        return result;
+    }
+};
+
+static void PrintResult(const BenchResult &r)
+{
+    printf("%-44s %12.1f %12.1f %12.1f %10.1f %12.1f %12llu", r.name.c_str(), r.minNs, r.medianNs, r.meanNs,
+           r.stddevNs, r.maxNs, (unsigned long long)r.iterations);
+    for (const auto &counter : r.counters) {
+        printf("  %s=%.4g", counter.first.c_str(), counter.second);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+static bool WriteJson(const char *path, const std::vector<BenchResult> &results)
+{
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return false;
+    }
+    fprintf(file, "{\n  \"unit\": \"ns/op\",\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &r = results[i];
+        fprintf(file,
+                "    {\"name\": \"%s\", \"iterations\": %llu, \"min\": %.3f, \"median\": %.3f, \"mean\": %.3f, "
+                "\"stddev\": %.3f, \"max\": %.3f",
+                r.name.c_str(), (unsigned long long)r.iterations, r.minNs, r.medianNs, r.meanNs, r.stddevNs,
+                r.maxNs);
+        for (const auto &counter : r.counters) {
+            fprintf(file, ", \"%s\": %.6g", counter.first.c_str(), counter.second);
+        }
+        fprintf(file, "}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+// Reads back the medians from a file written by WriteJson; one benchmark object per line.
+static bool ReadBaseline(const char *path, std::map<std::string, double> &medians)
+{
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "cannot read baseline %s\n", path);
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t namePos = line.find("\"name\": \"");
+        size_t medianPos = line.find("\"median\": ");
+        if (namePos == std::string::npos || medianPos == std::string::npos) {
+            continue;
+        }
+        namePos += strlen("\"name\": \"");
+        size_t nameEnd = line.find('"', namePos);
+        medians[line.substr(namePos, nameEnd - namePos)] = atof(line.c_str() + medianPos + strlen("\"median\": "));
+    }
+    return true;
+}
+
+static void PrintUsage(const char *argv0)
+{
+    printf("usage: %s [--filter <substring>] [--json <out.json>] [--baseline <base.json> [--threshold <pct>]]\n",
+           argv0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = nullptr;
+    const char *jsonPath = nullptr;
+    const char *baselinePath = nullptr;
+    double threshold = BENCH_DEFAULT_THRESHOLD_PERCENT;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else {
+            PrintUsage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (baselinePath && !ReadBaseline(baselinePath, baseline)) {
+        return 2;
+    }
+
+    printf("%-44s %12s %12s %12s %10s %12s %12s\n", "benchmark (ns/op)", "min", "median", "mean", "stddev", "max",
+           "iterations");
+    std::vector<BenchResult> results;
+    for (const BenchEntry &entry : Registry()) {
+        if (filter && entry.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        results.push_back(BenchRunner::Run(entry));
+        PrintResult(results.back());
+    }
+
+    if (jsonPath && !WriteJson(jsonPath, results)) {
+        return 2;
+    }
+
+    int regressions = 0;
+    for (const BenchResult &r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end() || it->second <= 0.0) {
+            continue;
+        }
+        double change = (r.medianNs - it->second) / it->second * 100.0;
+        if (change > threshold) {
+            printf("REGRESSION %s: median %.1f ns vs baseline %.1f ns (%+.1f%%, threshold %.1f%%)\n", r.name.c_str(),
+                   r.medianNs, it->second, change, threshold);
+            regressions++;
+        }
+    }
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_BENCHMARK_H
+#define BENCH_BENCHMARK_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Minimal microbenchmark harness for the host build.
+ * Each benchmark body runs state.iterations operations per call. The runner
+ * calibrates the count until one sample takes BENCH_MIN_SAMPLE_NS, then
+ * collects BENCH_SAMPLES samples and reports nanoseconds per operation.
+ */
+class BenchState {
+public:
+    explicit BenchState(uint64_t iterations) : iterations(iterations) {}
+
+    // Excludes setup done inside the body from the sample.
+    void ResetTimer();
+    // Ends the sample early, so verification after the timed loop is not counted.
+    void StopTimer();
+    // Extra per-benchmark figures that go into the report and JSON output.
+    void SetCounter(const std::string &name, double value);
+
+    const uint64_t iterations;
+
+private:
+    friend class BenchRunner;
+    int64_t startNs_ = 0;
+    int64_t stopNs_ = 0;
+    std::vector<std::pair<std::string, double>> counters_;
+};
+
+using BenchFunction = std::function<void(BenchState &)>;
+
+int RegisterBenchmark(const char *name, BenchFunction function);
+
+// Keeps the compiler from discarding a result that is otherwise unused.
+template <typename T> inline void DoNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void ClobberMemory()
+{
+    asm volatile("" : : : "memory");
+}
+
+#define BENCH_CONCAT_INNER(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_INNER(a, b)
+#define BENCHMARK(name, function) \
+    static int BENCH_CONCAT(g_benchRegistered, __LINE__) = RegisterBenchmark(name, function)
+
+#endif // BENCH_BENCHMARK_H
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "render/event_channel.h"
+#include "stubs/napi_stub_env.h"
+
+/**
+ * Event delivery checks, run by ctest on the host build. The NAPI stub holds
+ * threadsafe-function calls back the way a busy JS thread would, so a check
+ * can post and flush while an earlier batch is still waiting, then see what
+ * the callback receives once the queue drains.
+ */
+
+#define EVENT_SURFACE_W 466
+#define EVENT_SURFACE_H 466
+
+// What the JS callback saw of one batch.
+struct SeenBatch {
+    uint32_t types;
+    int32_t frames;
+    int32_t surfaceState;
+    bool surfaceDestroyed;
+};
+
+static std::vector<SeenBatch> g_seen;
+
+static double NumberProperty(napi_value object, const char *name)
+{
+    napi_value value = NapiStub::Property(object, name);
+    return value ? NapiStub::ToNumber(value) : -1.0;
+}
+
+static void OnBatch(napi_value batch)
+{
+    g_seen.push_back({(uint32_t)NumberProperty(batch, "types"), (int32_t)NumberProperty(batch, "frames"),
+                      (int32_t)NumberProperty(batch, "surfaceState"),
+                      NumberProperty(batch, "surfaceDestroyed") == 1.0});
+}
+
+static uint32_t SubscribeDeferred(EventChannel &channel)
+{
+    napi_threadsafe_function tsfn = nullptr;
+    napi_create_threadsafe_function(NapiStub::Env(), NapiStub::Function(OnBatch), nullptr, nullptr, 0, 1, nullptr,
+                                    nullptr, nullptr, EventChannel::CallJs, &tsfn);
+    NapiStub::DeferThreadsafeCalls(true);
+    g_seen.clear();
+    return channel.Subscribe(RENDER_EVENT_ALL, tsfn);
+}
+
+static bool Finish(const char *name, EventChannel &channel, uint32_t subscription, bool pass)
+{
+    NapiStub::RunQueuedCalls();
+    NapiStub::DeferThreadsafeCalls(false);
+    channel.Unsubscribe(subscription);
+    printf("%s %s: %zu batches\n", pass ? "PASS" : "FAIL", name, g_seen.size());
+    for (const SeenBatch &batch : g_seen) {
+        printf("  types %u frames %d surfaceState %d surfaceDestroyed %d\n", batch.types, batch.frames,
+               batch.surfaceState, batch.surfaceDestroyed ? 1 : 0);
+    }
+    return pass;
+}
+
+// A new surface reported in the same batch as the old one's destruction.
+static bool DestroyedThenCreatedInOneBatch(const char *name)
+{
+    EventChannel channel;
+    uint32_t subscription = SubscribeDeferred(channel);
+    channel.PostSurface(SURFACE_DESTROYED, EVENT_SURFACE_W, EVENT_SURFACE_H);
+    channel.PostSurface(SURFACE_CREATED, EVENT_SURFACE_W, EVENT_SURFACE_H);
+    channel.Flush();
+    NapiStub::RunQueuedCalls();
+    bool pass = g_seen.size() == 1 && g_seen[0].surfaceState == SURFACE_CREATED && g_seen[0].surfaceDestroyed;
+    return Finish(name, channel, subscription, pass);
+}
+
+// OnSurfaceDestroyed flushes on the JS thread while the last stats batch is still queued for it.
+static bool DestroyedPastQueuedBatch(const char *name)
+{
+    EventChannel channel;
+    uint32_t subscription = SubscribeDeferred(channel);
+    channel.PostFrame(16.7, 2.0, 2);
+    channel.Flush();
+    channel.PostSurface(SURFACE_DESTROYED, EVENT_SURFACE_W, EVENT_SURFACE_H);
+    channel.Flush();
+    // The next surface arrives before the JS thread got to either batch.
+    channel.PostSurface(SURFACE_CREATED, EVENT_SURFACE_W, EVENT_SURFACE_H);
+    channel.Flush();
+    NapiStub::RunQueuedCalls();
+    channel.Flush();
+    NapiStub::RunQueuedCalls();
+    bool pass = g_seen.size() == 3 && g_seen[0].types == RENDER_EVENT_FRAME_STATS && g_seen[0].frames == 1 &&
+                g_seen[1].types == RENDER_EVENT_SURFACE && g_seen[1].surfaceState == SURFACE_DESTROYED &&
+                g_seen[1].surfaceDestroyed && g_seen[2].surfaceState == SURFACE_CREATED &&
+                !g_seen[2].surfaceDestroyed;
+    return Finish(name, channel, subscription, pass);
+}
+
+struct EventCheck {
+    const char *name;
+    bool (*run)(const char *name);
+};
+
+static const EventCheck EVENT_CHECKS[] = {
+    {"events/destroyed_then_created", DestroyedThenCreatedInOneBatch},
+    {"events/destroyed_past_queued_batch", DestroyedPastQueuedBatch},
+};
+
+int main()
+{
+    int32_t failed = 0;
+    for (const EventCheck &check : EVENT_CHECKS) {
+        failed += check.run(check.name) ? 0 : 1;
+    }
+    return failed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <GLES3/gl3.h>
+#include "bench_fixtures.h"
+#include "render/egl_core_shader.h"
+#include "render/field_cache.h"
+#include "render/metaball_scene.h"
+#include "render/soft_core.h"
+
+/**
+ * Image parity checks between the renderers, run by ctest on the host build.
+ * Each check draws the bench scene through two paths and compares the RGBA8
+ * results channel by channel. GL checks need an EGL driver with pbuffer
+ * configs (EGL_PLATFORM=surfaceless on Mesa) and are skipped without one.
+ */
+
+#define PARITY_FRAME_NS 16666667LL
+// Sparse enough to put all three bands and plenty of isolines on screen; at MAX_METABALLS the
+// default balls bury the whole panel in the core band and the comparison proves nothing.
+#define PARITY_BALLS 20
+// Frames of hand-dragging one ball, kept under the field cache's rebuild interval so the
+// updates pile up in the cached field instead of being wiped by a rebuild.
+#define PARITY_CACHE_MOVES 60
+// ctest's SKIP_RETURN_CODE for this test.
+#define PARITY_EXIT_SKIPPED 77
+
+enum ParityResult { PARITY_PASS, PARITY_FAIL, PARITY_SKIP };
+
+// Top-down RGBA8888 of the current framebuffer, the row order SoftCore writes.
+static std::vector<uint32_t> ReadFramebuffer(int32_t w, int32_t h)
+{
+    std::vector<uint32_t> bottomUp((size_t)w * h);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, bottomUp.data());
+    std::vector<uint32_t> pixels((size_t)w * h);
+    for (int32_t y = 0; y < h; y++) {
+        std::copy_n(&bottomUp[(size_t)(h - 1 - y) * w], w, &pixels[(size_t)y * w]);
+    }
+    return pixels;
+}
+
+static ParityResult CompareImages(const char *name, const std::vector<uint32_t> &expected,
+                                  const std::vector<uint32_t> &actual, int32_t tolerance)
+{
+    if (std::all_of(expected.begin(), expected.end(), [&](uint32_t p) { return p == expected[0]; })) {
+        printf("FAIL %s: reference image is a single color\n", name);
+        return PARITY_FAIL;
+    }
+    int32_t maxDiff = 0;
+    size_t over = 0;
+    for (size_t i = 0; i < expected.size(); i++) {
+        int32_t pixelDiff = 0;
+        for (int32_t shift = 0; shift < 24; shift += 8) {
+            int32_t want = (int32_t)((expected[i] >> shift) & 0xFFu);
+            int32_t got = (int32_t)((actual[i] >> shift) & 0xFFu);
+            int32_t diff = std::abs(want - got);
+            pixelDiff = std::max(pixelDiff, diff);
+        }
+        maxDiff = std::max(maxDiff, pixelDiff);
+        over += pixelDiff > tolerance ? 1 : 0;
+    }
+    bool pass = over == 0;
+    printf("%s %s: max diff %d LSB, %zu of %zu pixels over %d\n", pass ? "PASS" : "FAIL", name, maxDiff, over,
+           expected.size(), tolerance);
+    return pass ? PARITY_PASS : PARITY_FAIL;
+}
+
+// g_fragmentShader against SoftCore::RenderToBuffer on the same packed frame; tinted paints every other ball.
+static ParityResult SoftCoreMatchesShader(const char *name, bool tinted, bool culling)
+{
+    std::string id("parity");
+    EGLCore core(id);
+    if (!InitOffscreenCore(core, SurfaceRequest(), BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT)) {
+        printf("SKIP %s: no EGL pbuffer support\n", name);
+        return PARITY_SKIP;
+    }
+    // The CPU path draws hard edges.
+    core.SetEdgeAntialiasing(false);
+    core.SetBlockCulling(culling);
+    SeedScene(PARITY_BALLS);
+    if (tinted) {
+        for (size_t i = 0; i < PARITY_BALLS; i += 2) {
+            core.SetMetaballColor(g_metaballs.HandleAt(i), 0x4080FFu + (uint32_t)i * 0x010203u);
+        }
+    }
+    core.RenderLoop(PARITY_FRAME_NS);
+    std::vector<uint32_t> gl = ReadFramebuffer(BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT);
+    ReleaseOffscreenCore(core);
+
+    // RenderLoop packed exactly the frame it drew.
+    SoftCore soft(1);
+    soft.SetBlockCulling(culling);
+    std::vector<uint32_t> cpu((size_t)BENCH_SCENE_WIDTH * BENCH_SCENE_HEIGHT);
+    soft.RenderToBuffer(g_metaballPositions, g_metaballWeights, g_metaballColors, PARITY_BALLS, cpu.data(),
+                        BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT, BENCH_SCENE_WIDTH * (int32_t)sizeof(uint32_t));
+    return CompareImages(name, gl, cpu, 1);
+}
+
+// Runs the parity frame sequence: a frame to start the clock, a still frame (the cache rebuilds),
+// then one ball dragged across the panel (the cache updates just that ball each frame). Same timestamp throughout, so the
+// simulation never steps. Returns the final frame and how many balls the field cache redrew for it.
+static bool RenderMovedFrame(bool incremental, std::vector<uint32_t> &pixels, int32_t &updatedBalls)
+{
+    std::string id("parity");
+    EGLCore core(id);
+    if (!InitOffscreenCore(core, SurfaceRequest(), BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT)) {
+        return false;
+    }
+    core.SetBlockCulling(false);
+    core.SetIncrementalField(incremental);
+    SeedScene(PARITY_BALLS);
+    core.RenderLoop(PARITY_FRAME_NS);
+    core.RenderLoop(PARITY_FRAME_NS);
+    for (int32_t i = 1; i <= PARITY_CACHE_MOVES; i++) {
+        float t = (float)i / PARITY_CACHE_MOVES;
+        core.MoveMetaball(g_metaballs.HandleAt(0), BENCH_SCENE_WIDTH * t, BENCH_SCENE_HEIGHT * (1.0f - t));
+        core.RenderLoop(PARITY_FRAME_NS);
+    }
+    pixels = ReadFramebuffer(BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT);
+    updatedBalls = core.fieldCache_ ? core.fieldCache_->LastUpdatedBalls() : 0;
+    ReleaseOffscreenCore(core);
+    return true;
+}
+
+// The incremental field cache against DrawField, antialiased edges included.
+static ParityResult FieldCacheMatchesDirect(const char *name)
+{
+    std::vector<uint32_t> direct;
+    std::vector<uint32_t> cached;
+    int32_t updatedBalls = 0;
+    if (!RenderMovedFrame(false, direct, updatedBalls) || !RenderMovedFrame(true, cached, updatedBalls)) {
+        printf("SKIP %s: no EGL pbuffer support\n", name);
+        return PARITY_SKIP;
+    }
+    if (updatedBalls != 1) {
+        // No blendable R32F target, or the cache declined the frame: nothing to compare.
+        printf("SKIP %s: field cache redrew %d balls, expected 1\n", name, updatedBalls);
+        return PARITY_SKIP;
+    }
+    return CompareImages(name, direct, cached, 1);
+}
+
+struct ParityCheck {
+    const char *name;
+    ParityResult (*run)(const char *name);
+};
+
+static const ParityCheck PARITY_CHECKS[] = {
+    {"soft_core/white", [](const char *name) { return SoftCoreMatchesShader(name, false, false); }},
+    {"soft_core/tinted", [](const char *name) { return SoftCoreMatchesShader(name, true, false); }},
+    {"soft_core/white_culled", [](const char *name) { return SoftCoreMatchesShader(name, false, true); }},
+    {"soft_core/tinted_culled", [](const char *name) { return SoftCoreMatchesShader(name, true, true); }},
+    {"field_cache/moved_ball", FieldCacheMatchesDirect},
+};
+
+int main()
+{
+    int32_t failed = 0;
+    int32_t skipped = 0;
+    for (const ParityCheck &check : PARITY_CHECKS) {
+        ParityResult result = check.run(check.name);
+        failed += result == PARITY_FAIL ? 1 : 0;
+        skipped += result == PARITY_SKIP ? 1 : 0;
+    }
+    if (failed > 0) {
+        return EXIT_FAILURE;
+    }
+    return skipped == (int32_t)(sizeof(PARITY_CHECKS) / sizeof(PARITY_CHECKS[0])) ? PARITY_EXIT_SKIPPED
+                                                                                    : EXIT_SUCCESS;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_STUB_NATIVE_INTERFACE_XCOMPONENT_H
+#define BENCH_STUB_NATIVE_INTERFACE_XCOMPONENT_H
+
+// Host stand-in for the XComponent NDK interface.
+#include <stdint.h>
+
+#define OH_XCOMPONENT_ID_LEN_MAX 128
+#define OH_NATIVE_XCOMPONENT_OBJ "__NATIVE_XCOMPONENT_OBJ__"
+
+enum { OH_NATIVEXCOMPONENT_RESULT_SUCCESS = 0, OH_NATIVEXCOMPONENT_RESULT_FAILED = -1 };
+
+typedef struct OH_NativeXComponent OH_NativeXComponent;
+
+enum OH_NativeXComponent_TouchEventType {
+    OH_NATIVEXCOMPONENT_DOWN = 0,
+    OH_NATIVEXCOMPONENT_UP,
+    OH_NATIVEXCOMPONENT_MOVE,
+    OH_NATIVEXCOMPONENT_CANCEL,
+    OH_NATIVEXCOMPONENT_UNKNOWN,
+};
+
+typedef struct {
+    int32_t id;
+    float screenX;
+    float screenY;
+    float x;
+    float y;
+    OH_NativeXComponent_TouchEventType type;
+} OH_NativeXComponent_TouchEvent;
+
+typedef struct {
+    void (*OnSurfaceCreated)(OH_NativeXComponent *component, void *window);
+    void (*OnSurfaceChanged)(OH_NativeXComponent *component, void *window);
+    void (*OnSurfaceDestroyed)(OH_NativeXComponent *component, void *window);
+    void (*DispatchTouchEvent)(OH_NativeXComponent *component, void *window);
+} OH_NativeXComponent_Callback;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+int32_t OH_NativeXComponent_GetXComponentId(OH_NativeXComponent *component, char *id, uint64_t *size);
+int32_t OH_NativeXComponent_GetXComponentSize(OH_NativeXComponent *component, const void *window, uint64_t *width,
+                                              uint64_t *height);
+int32_t OH_NativeXComponent_RegisterCallback(OH_NativeXComponent *component, OH_NativeXComponent_Callback *callback);
+int32_t OH_NativeXComponent_GetTouchEvent(OH_NativeXComponent *component, const void *window,
+                                          OH_NativeXComponent_TouchEvent *touchEvent);
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BENCH_STUB_NATIVE_INTERFACE_XCOMPONENT_H
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_STUB_NAPI_NATIVE_API_H
+#define BENCH_STUB_NAPI_NATIVE_API_H
+
+// Host stand-in for the subset of Node-API that the entry points use.
+// Signatures follow the OHOS NDK headers; bench/stubs/napi_stub.cpp implements them.
+#include <stddef.h>
+#include <stdint.h>
+
+#define NAPI_AUTO_LENGTH SIZE_MAX
+
+typedef struct napi_env__ *napi_env;
+typedef struct napi_value__ *napi_value;
+typedef struct napi_callback_info__ *napi_callback_info;
+typedef struct napi_threadsafe_function__ *napi_threadsafe_function;
+
+typedef enum {
+    napi_ok,
+    napi_invalid_arg,
+    napi_object_expected,
+    napi_string_expected,
+    napi_name_expected,
+    napi_function_expected,
+    napi_number_expected,
+    napi_boolean_expected,
+    napi_array_expected,
+    napi_generic_failure,
+    napi_pending_exception,
+    napi_cancelled,
+    napi_escape_called_twice,
+    napi_handle_scope_mismatch,
+    napi_callback_scope_mismatch,
+    napi_queue_full,
+    napi_closing,
+    napi_bigint_expected,
+} napi_status;
+
+typedef enum {
+    napi_undefined,
+    napi_null,
+    napi_boolean,
+    napi_number,
+    napi_string,
+    napi_symbol,
+    napi_object,
+    napi_function,
+    napi_external,
+    napi_bigint,
+} napi_valuetype;
+
+typedef enum {
+    napi_int8_array,
+    napi_uint8_array,
+    napi_uint8_clamped_array,
+    napi_int16_array,
+    napi_uint16_array,
+    napi_int32_array,
+    napi_uint32_array,
+    napi_float32_array,
+    napi_float64_array,
+    napi_bigint64_array,
+    napi_biguint64_array,
+} napi_typedarray_type;
+
+typedef enum { napi_default = 0 } napi_property_attributes;
+typedef enum { napi_tsfn_release, napi_tsfn_abort } napi_threadsafe_function_release_mode;
+typedef enum { napi_tsfn_nonblocking, napi_tsfn_blocking } napi_threadsafe_function_call_mode;
+
+typedef napi_value (*napi_callback)(napi_env env, napi_callback_info info);
+typedef void (*napi_finalize)(napi_env env, void *data, void *hint);
+typedef void (*napi_threadsafe_function_call_js)(napi_env env, napi_value jsCallback, void *context, void *data);
+
+typedef struct {
+    const char *utf8name;
+    napi_value name;
+    napi_callback method;
+    napi_callback getter;
+    napi_callback setter;
+    napi_value value;
+    napi_property_attributes attributes;
+    void *data;
+} napi_property_descriptor;
+
+typedef struct {
+    int nm_version;
+    unsigned int nm_flags;
+    const char *nm_filename;
+    napi_value (*nm_register_func)(napi_env env, napi_value exports);
+    const char *nm_modname;
+    void *nm_priv;
+    void *reserved[4];
+} napi_module;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+napi_status napi_get_cb_info(napi_env env, napi_callback_info info, size_t *argc, napi_value *argv,
+                             napi_value *thisArg, void **data);
+napi_status napi_typeof(napi_env env, napi_value value, napi_valuetype *result);
+napi_status napi_get_value_double(napi_env env, napi_value value, double *result);
+napi_status napi_get_value_int32(napi_env env, napi_value value, int32_t *result);
+napi_status napi_get_value_uint32(napi_env env, napi_value value, uint32_t *result);
+napi_status napi_get_value_int64(napi_env env, napi_value value, int64_t *result);
+napi_status napi_get_value_bool(napi_env env, napi_value value, bool *result);
+napi_status napi_get_value_string_utf8(napi_env env, napi_value value, char *buf, size_t bufsize, size_t *result);
+napi_status napi_get_typedarray_info(napi_env env, napi_value typedarray, napi_typedarray_type *type,
+                                     size_t *length, void **data, napi_value *arraybuffer, size_t *byteOffset);
+napi_status napi_create_object(napi_env env, napi_value *result);
+napi_status napi_create_double(napi_env env, double value, napi_value *result);
+napi_status napi_create_int32(napi_env env, int32_t value, napi_value *result);
+napi_status napi_create_uint32(napi_env env, uint32_t value, napi_value *result);
+napi_status napi_get_boolean(napi_env env, bool value, napi_value *result);
+napi_status napi_get_undefined(napi_env env, napi_value *result);
+napi_status napi_get_null(napi_env env, napi_value *result);
+napi_status napi_create_string_utf8(napi_env env, const char *str, size_t length, napi_value *result);
+napi_status napi_create_arraybuffer(napi_env env, size_t byteLength, void **data, napi_value *result);
+napi_status napi_create_typedarray(napi_env env, napi_typedarray_type type, size_t length, napi_value arraybuffer,
+                                   size_t byteOffset, napi_value *result);
+napi_status napi_get_named_property(napi_env env, napi_value object, const char *utf8name, napi_value *result);
+napi_status napi_set_named_property(napi_env env, napi_value object, const char *utf8name, napi_value value);
+napi_status napi_define_properties(napi_env env, napi_value object, size_t propertyCount,
+                                   const napi_property_descriptor *properties);
+napi_status napi_unwrap(napi_env env, napi_value jsObject, void **result);
+napi_status napi_call_function(napi_env env, napi_value recv, napi_value func, size_t argc, const napi_value *argv,
+                               napi_value *result);
+napi_status napi_throw_type_error(napi_env env, const char *code, const char *msg);
+napi_status napi_create_threadsafe_function(napi_env env, napi_value func, napi_value asyncResource,
+                                            napi_value asyncResourceName, size_t maxQueueSize,
+                                            size_t initialThreadCount, void *threadFinalizeData,
+                                            napi_finalize threadFinalizeCb, void *context,
+                                            napi_threadsafe_function_call_js callJsCb,
+                                            napi_threadsafe_function *result);
+napi_status napi_call_threadsafe_function(napi_threadsafe_function func, void *data,
+                                          napi_threadsafe_function_call_mode isBlocking);
+napi_status napi_release_threadsafe_function(napi_threadsafe_function func,
+                                             napi_threadsafe_function_release_mode mode);
+void napi_module_register(napi_module *mod);
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BENCH_STUB_NAPI_NATIVE_API_H
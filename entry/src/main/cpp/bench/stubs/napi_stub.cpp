@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "napi_stub_env.h"
+
+#define STUB_MAX_ARGS 8
+#define STUB_SCRATCH_VALUES 64
+
+struct napi_env__ {
+    int unused;
+};
+
+struct napi_value__ {
+    napi_valuetype type = napi_undefined;
+    double number = 0.0;
+    bool boolean = false;
+    std::string str;
+    napi_typedarray_type arrayType = napi_uint8_array;
+    void *data = nullptr;
+    size_t length = 0;
+    bool isTypedArray = false;
+    std::vector<uint8_t> storage;
+    void (*function)(napi_value arg) = nullptr;
+    // Names are the literals native code passes in, so no copies are kept.
+    std::vector<std::pair<const char *, napi_value>> properties;
+};
+
+struct napi_callback_info__ {
+    size_t argc = 0;
+    napi_value argv[STUB_MAX_ARGS] = {};
+};
+
+struct napi_threadsafe_function__ {
+    napi_value func;
+    napi_threadsafe_function_call_js callJs;
+    void *context;
+};
+
+struct QueuedCall {
+    napi_threadsafe_function func;
+    void *data;
+};
+
+static napi_env__ g_env;
+static napi_value__ g_scratch[STUB_SCRATCH_VALUES];
+static size_t g_scratchNext = 0;
+static int g_wrappedComponent = 0;
+static bool g_deferCalls = false;
+static std::vector<QueuedCall> g_queuedCalls;
+
+static napi_value NextScratch(napi_valuetype type)
+{
+    napi_value value = &g_scratch[g_scratchNext++ % STUB_SCRATCH_VALUES];
+    value->type = type;
+    value->isTypedArray = false;
+    value->function = nullptr;
+    value->properties.clear();
+    return value;
+}
+
+namespace NapiStub {
+napi_env Env()
+{
+    return &g_env;
+}
+
+napi_value Number(double value)
+{
+    napi_value result = new napi_value__();
+    result->type = napi_number;
+    result->number = value;
+    return result;
+}
+
+napi_value Boolean(bool value)
+{
+    napi_value result = new napi_value__();
+    result->type = napi_boolean;
+    result->boolean = value;
+    return result;
+}
+
+napi_value String(const char *value)
+{
+    napi_value result = new napi_value__();
+    result->type = napi_string;
+    result->str = value;
+    return result;
+}
+
+napi_value Float32Array(float *data, size_t length)
+{
+    napi_value result = new napi_value__();
+    result->type = napi_object;
+    result->isTypedArray = true;
+    result->arrayType = napi_float32_array;
+    result->data = data;
+    result->length = length;
+    return result;
+}
+
+napi_value Context()
+{
+    napi_value result = new napi_value__();
+    result->type = napi_object;
+    return result;
+}
+
+napi_callback_info CallInfo(std::initializer_list<napi_value> args)
+{
+    napi_callback_info info = new napi_callback_info__();
+    for (napi_value arg : args) {
+        if (info->argc < STUB_MAX_ARGS) {
+            info->argv[info->argc++] = arg;
+        }
+    }
+    return info;
+}
+
+double ToNumber(napi_value value)
+{
+    if (!value) {
+        return 0.0;
+    }
+    return value->type == napi_boolean ? (value->boolean ? 1.0 : 0.0) : value->number;
+}
+
+napi_value Function(void (*callback)(napi_value arg))
+{
+    napi_value result = new napi_value__();
+    result->type = napi_function;
+    result->function = callback;
+    return result;
+}
+
+napi_value Property(napi_value object, const char *name)
+{
+    for (const auto &property : object->properties) {
+        if (strcmp(property.first, name) == 0) {
+            return property.second;
+        }
+    }
+    return nullptr;
+}
+
+void DeferThreadsafeCalls(bool defer)
+{
+    g_deferCalls = defer;
+}
+
+size_t RunQueuedCalls()
+{
+    std::vector<QueuedCall> calls;
+    calls.swap(g_queuedCalls);
+    for (const QueuedCall &call : calls) {
+        call.func->callJs(&g_env, call.func->func, call.func->context, call.data);
+    }
+    return calls.size();
+}
+} // namespace NapiStub
+
+extern "C" {
+napi_status napi_get_cb_info(napi_env env, napi_callback_info info, size_t *argc, napi_value *argv,
+                             napi_value *thisArg, void **data)
+{
+    if (argv) {
+        for (size_t i = 0; i < *argc; i++) {
+            argv[i] = i < info->argc ? info->argv[i] : nullptr;
+        }
+    }
+    *argc = info->argc;
+    return napi_ok;
+}
+
+napi_status napi_typeof(napi_env env, napi_value value, napi_valuetype *result)
+{
+    *result = value ? value->type : napi_undefined;
+    return napi_ok;
+}
+
+napi_status napi_get_value_double(napi_env env, napi_value value, double *result)
+{
+    if (!value || value->type != napi_number) {
+        return napi_number_expected;
+    }
+    *result = value->number;
+    return napi_ok;
+}
+
+napi_status napi_get_value_int32(napi_env env, napi_value value, int32_t *result)
+{
+    if (!value || value->type != napi_number) {
+        return napi_number_expected;
+    }
+    *result = (int32_t)value->number;
+    return napi_ok;
+}
+
+napi_status napi_get_value_uint32(napi_env env, napi_value value, uint32_t *result)
+{
+    if (!value || value->type != napi_number) {
+        return napi_number_expected;
+    }
+    *result = (uint32_t)value->number;
+    return napi_ok;
+}
+
+napi_status napi_get_value_int64(napi_env env, napi_value value, int64_t *result)
+{
+    if (!value || value->type != napi_number) {
+        return napi_number_expected;
+    }
+    *result = (int64_t)value->number;
+    return napi_ok;
+}
+
+napi_status napi_get_value_bool(napi_env env, napi_value value, bool *result)
+{
+    if (!value || value->type != napi_boolean) {
+        return napi_boolean_expected;
+    }
+    *result = value->boolean;
+    return napi_ok;
+}
+
+napi_status napi_get_value_string_utf8(napi_env env, napi_value value, char *buf, size_t bufsize, size_t *result)
+{
+    if (!value || value->type != napi_string) {
+        return napi_string_expected;
+    }
+    size_t n = value->str.size() < bufsize - 1 ? value->str.size() : bufsize - 1;
+    memcpy(buf, value->str.data(), n);
+    buf[n] = '\0';
+    if (result) {
+        *result = n;
+    }
+    return napi_ok;
+}
+
+napi_status napi_get_typedarray_info(napi_env env, napi_value typedarray, napi_typedarray_type *type,
+                                     size_t *length, void **data, napi_value *arraybuffer, size_t *byteOffset)
+{
+    if (!typedarray || !typedarray->isTypedArray) {
+        return napi_invalid_arg;
+    }
+    if (type) {
+        *type = typedarray->arrayType;
+    }
+    if (length) {
+        *length = typedarray->length;
+    }
+    if (data) {
+        *data = typedarray->data;
+    }
+    if (byteOffset) {
+        *byteOffset = 0;
+    }
+    return napi_ok;
+}
+
+napi_status napi_create_object(napi_env env, napi_value *result)
+{
+    *result = NextScratch(napi_object);
+    return napi_ok;
+}
+
+napi_status napi_create_double(napi_env env, double value, napi_value *result)
+{
+    *result = NextScratch(napi_number);
+    (*result)->number = value;
+    return napi_ok;
+}
+
+napi_status napi_create_int32(napi_env env, int32_t value, napi_value *result)
+{
+    return napi_create_double(env, value, result);
+}
+
+napi_status napi_create_uint32(napi_env env, uint32_t value, napi_value *result)
+{
+    return napi_create_double(env, value, result);
+}
+
+napi_status napi_get_boolean(napi_env env, bool value, napi_value *result)
+{
+    *result = NextScratch(napi_boolean);
+    (*result)->boolean = value;
+    return napi_ok;
+}
+
+napi_status napi_get_undefined(napi_env env, napi_value *result)
+{
+    *result = NextScratch(napi_undefined);
+    return napi_ok;
+}
+
+napi_status napi_get_null(napi_env env, napi_value *result)
+{
+    *result = NextScratch(napi_null);
+    return napi_ok;
+}
+
+napi_status napi_create_string_utf8(napi_env env, const char *str, size_t length, napi_value *result)
+{
+    *result = NextScratch(napi_string);
+    (*result)->str.assign(str, length == NAPI_AUTO_LENGTH ? strlen(str) : length);
+    return napi_ok;
+}
+
+napi_status napi_create_arraybuffer(napi_env env, size_t byteLength, void **data, napi_value *result)
+{
+    *result = NextScratch(napi_object);
+    // Scratch storage only grows, so steady-state calls do not allocate.
+    if ((*result)->storage.size() < byteLength) {
+        (*result)->storage.resize(byteLength);
+    }
+    (*result)->data = (*result)->storage.data();
+    (*result)->length = byteLength;
+    *data = (*result)->data;
+    return napi_ok;
+}
+
+napi_status napi_create_typedarray(napi_env env, napi_typedarray_type type, size_t length, napi_value arraybuffer,
+                                   size_t byteOffset, napi_value *result)
+{
+    *result = NextScratch(napi_object);
+    (*result)->isTypedArray = true;
+    (*result)->arrayType = type;
+    (*result)->data = static_cast<uint8_t *>(arraybuffer->data) + byteOffset;
+    (*result)->length = length;
+    return napi_ok;
+}
+
+napi_status napi_get_named_property(napi_env env, napi_value object, const char *utf8name, napi_value *result)
+{
+    *result = object;
+    return napi_ok;
+}
+
+napi_status napi_set_named_property(napi_env env, napi_value object, const char *utf8name, napi_value value)
+{
+    object->properties.emplace_back(utf8name, value);
+    return napi_ok;
+}
+
+napi_status napi_define_properties(napi_env env, napi_value object, size_t propertyCount,
+                                   const napi_property_descriptor *properties)
+{
+    return napi_ok;
+}
+
+napi_status napi_unwrap(napi_env env, napi_value jsObject, void **result)
+{
+    *result = &g_wrappedComponent;
+    return napi_ok;
+}
+
+napi_status napi_call_function(napi_env env, napi_value recv, napi_value func, size_t argc, const napi_value *argv,
+                               napi_value *result)
+{
+    if (func && func->function) {
+        func->function(argc > 0 ? argv[0] : nullptr);
+    }
+    if (result) {
+        *result = NextScratch(napi_undefined);
+    }
+    return napi_ok;
+}
+
+napi_status napi_throw_type_error(napi_env env, const char *code, const char *msg)
+{
+    return napi_ok;
+}
+
+napi_status napi_create_threadsafe_function(napi_env env, napi_value func, napi_value asyncResource,
+                                            napi_value asyncResourceName, size_t maxQueueSize,
+                                            size_t initialThreadCount, void *threadFinalizeData,
+                                            napi_finalize threadFinalizeCb, void *context,
+                                            napi_threadsafe_function_call_js callJsCb,
+                                            napi_threadsafe_function *result)
+{
+    *result = new napi_threadsafe_function__{func, callJsCb, context};
+    return napi_ok;
+}
+
+// Calls straight through on the calling thread unless deferred; there is no JS loop on the host.
+napi_status napi_call_threadsafe_function(napi_threadsafe_function func, void *data,
+                                          napi_threadsafe_function_call_mode isBlocking)
+{
+    if (g_deferCalls) {
+        g_queuedCalls.push_back({func, data});
+        return napi_ok;
+    }
+    func->callJs(&g_env, func->func, func->context, data);
+    return napi_ok;
+}
+
+napi_status napi_release_threadsafe_function(napi_threadsafe_function func,
+                                             napi_threadsafe_function_release_mode mode)
+{
+    delete func;
+    return napi_ok;
+}
+
+void napi_module_register(napi_module *mod)
+{
+}
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_NAPI_STUB_ENV_H
+#define BENCH_NAPI_STUB_ENV_H
+
+#include <initializer_list>
+#include <napi/native_api.h>
+
+/**
+ * In-process fake of a JS engine for driving NAPI entry points on the host.
+ * Argument values are built once during benchmark setup; values created by
+ * the entry points land in a fixed scratch ring, so the measured loop does
+ * not allocate on the stub side.
+ */
+namespace NapiStub {
+napi_env Env();
+napi_value Number(double value);
+napi_value Boolean(bool value);
+napi_value String(const char *value);
+napi_value Float32Array(float *data, size_t length);
+// Stands in for the XComponent context object that ArkTS passes as the first argument.
+napi_value Context();
+napi_callback_info CallInfo(std::initializer_list<napi_value> args);
+double ToNumber(napi_value value);
+// A JS function that calls back into the host with its first argument.
+napi_value Function(void (*callback)(napi_value arg));
+// A property set on object by native code, or nullptr.
+napi_value Property(napi_value object, const char *name);
+// While deferred, threadsafe-function calls queue up instead of running on the caller, the way
+// they wait for a busy JS thread; RunQueuedCalls drains them in order and returns how many ran.
+void DeferThreadsafeCalls(bool defer);
+size_t RunQueuedCalls();
+} // namespace NapiStub
+
+#endif // BENCH_NAPI_STUB_ENV_H
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_STUB_NATIVE_VSYNC_H
+#define BENCH_STUB_NATIVE_VSYNC_H
+
+// Host stand-in for the OHOS native VSync API.
+typedef struct OH_NativeVSync OH_NativeVSync;
+typedef void (*OH_NativeVSync_FrameCallback)(long long timestamp, void *data);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+OH_NativeVSync *OH_NativeVSync_Create(const char *name, unsigned int length);
+void OH_NativeVSync_Destroy(OH_NativeVSync *nativeVsync);
+int OH_NativeVSync_RequestFrame(OH_NativeVSync *nativeVsync, OH_NativeVSync_FrameCallback callback, void *data);
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BENCH_STUB_NATIVE_VSYNC_H
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_STUB_EXTERNAL_WINDOW_H
+#define BENCH_STUB_EXTERNAL_WINDOW_H
+
+// Host stand-in for the OHOS native window API.
+#include <stdint.h>
+
+typedef struct NativeWindow OHNativeWindow;
+typedef struct NativeWindowBuffer OHNativeWindowBuffer;
+
+typedef struct {
+    int fd;
+    int32_t width;
+    int32_t stride;
+    int32_t height;
+    int32_t size;
+    int32_t format;
+    uint64_t usage;
+    void *virAddr;
+} BufferHandle;
+
+typedef struct Region {
+    struct Rect {
+        int32_t x;
+        int32_t y;
+        uint32_t w;
+        uint32_t h;
+    } *rects;
+    int32_t rectNumber;
+} Region;
+
+enum NativeWindowOperation {
+    SET_BUFFER_GEOMETRY,
+    GET_BUFFER_GEOMETRY,
+    GET_FORMAT,
+    SET_FORMAT,
+    GET_USAGE,
+    SET_USAGE,
+    SET_STRIDE,
+};
+
+enum {
+    NATIVEBUFFER_PIXEL_FMT_RGB_565 = 3,
+    NATIVEBUFFER_PIXEL_FMT_RGBX_8888 = 11,
+    NATIVEBUFFER_PIXEL_FMT_RGBA_8888 = 12,
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+int32_t OH_NativeWindow_NativeWindowHandleOpt(OHNativeWindow *window, int code, ...);
+int32_t OH_NativeWindow_NativeWindowRequestBuffer(OHNativeWindow *window, OHNativeWindowBuffer **buffer, int *fenceFd);
+int32_t OH_NativeWindow_NativeWindowFlushBuffer(OHNativeWindow *window, OHNativeWindowBuffer *buffer, int fenceFd,
+                                                Region region);
+int32_t OH_NativeWindow_NativeWindowAbortBuffer(OHNativeWindow *window, OHNativeWindowBuffer *buffer);
+BufferHandle *OH_NativeWindow_GetBufferHandleFromNative(OHNativeWindowBuffer *buffer);
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BENCH_STUB_EXTERNAL_WINDOW_H
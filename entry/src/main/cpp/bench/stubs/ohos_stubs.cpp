@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hilog/log.h>
+#include <ace/xcomponent/native_interface_xcomponent.h>
+#include <native_vsync/native_vsync.h>
+#include <native_window/external_window.h>
+
+// No-op host implementations of the OHOS system APIs linked by the render sources.
+extern "C" {
+int OH_LOG_Print(LogType type, LogLevel level, unsigned int domain, const char *tag, const char *fmt, ...)
+{
+    return 0;
+}
+
+int32_t OH_NativeXComponent_GetXComponentId(OH_NativeXComponent *component, char *id, uint64_t *size)
+{
+    return OH_NATIVEXCOMPONENT_RESULT_FAILED;
+}
+
+int32_t OH_NativeXComponent_GetXComponentSize(OH_NativeXComponent *component, const void *window, uint64_t *width,
+                                              uint64_t *height)
+{
+    return OH_NATIVEXCOMPONENT_RESULT_FAILED;
+}
+
+int32_t OH_NativeXComponent_RegisterCallback(OH_NativeXComponent *component, OH_NativeXComponent_Callback *callback)
+{
+    return OH_NATIVEXCOMPONENT_RESULT_SUCCESS;
+}
+
+int32_t OH_NativeXComponent_GetTouchEvent(OH_NativeXComponent *component, const void *window,
+                                          OH_NativeXComponent_TouchEvent *touchEvent)
+{
+    return OH_NATIVEXCOMPONENT_RESULT_FAILED;
+}
+
+OH_NativeVSync *OH_NativeVSync_Create(const char *name, unsigned int length)
+{
+    return nullptr;
+}
+
+void OH_NativeVSync_Destroy(OH_NativeVSync *nativeVsync)
+{
+}
+
+int OH_NativeVSync_RequestFrame(OH_NativeVSync *nativeVsync, OH_NativeVSync_FrameCallback callback, void *data)
+{
+    return -1;
+}
+
+int32_t OH_NativeWindow_NativeWindowHandleOpt(OHNativeWindow *window, int code, ...)
+{
+    return 0;
+}
+
+int32_t OH_NativeWindow_NativeWindowRequestBuffer(OHNativeWindow *window, OHNativeWindowBuffer **buffer, int *fenceFd)
+{
+    return -1;
+}
+
+int32_t OH_NativeWindow_NativeWindowFlushBuffer(OHNativeWindow *window, OHNativeWindowBuffer *buffer, int fenceFd,
+                                                Region region)
+{
+    return 0;
+}
+
+int32_t OH_NativeWindow_NativeWindowAbortBuffer(OHNativeWindow *window, OHNativeWindowBuffer *buffer)
+{
+    return 0;
+}
+
+BufferHandle *OH_NativeWindow_GetBufferHandleFromNative(OHNativeWindowBuffer *buffer)
+{
+    return nullptr;
+}
+}
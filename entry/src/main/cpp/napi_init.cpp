@@ -23,7 +23,29 @@ static napi_value Init(napi_env env, napi_value exports)
 {
     napi_property_descriptor desc[] = {
         { "addMetaball", nullptr, PluginRender::NapiAddMetaball, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "removeMetaball", nullptr, PluginRender::NapiRemoveMetaball, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "moveMetaball", nullptr, PluginRender::NapiMoveMetaball, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setMetaballRadius", nullptr, PluginRender::NapiSetMetaballRadius, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setMetaballStrength", nullptr, PluginRender::NapiSetMetaballStrength, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setMetaballColor", nullptr, PluginRender::NapiSetMetaballColor, nullptr, nullptr, nullptr, napi_default, nullptr },
         { "clearMetaballs", nullptr, PluginRender::NapiClearMetaballs, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setIncrementalField", nullptr, PluginRender::NapiSetIncrementalField, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setGpuSimulation", nullptr, PluginRender::NapiSetGpuSimulation, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setIsoLevels", nullptr, PluginRender::NapiSetIsoLevels, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setEdgeAntialiasing", nullptr, PluginRender::NapiSetEdgeAntialiasing, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setBlockCulling", nullptr, PluginRender::NapiSetBlockCulling, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setAttraction", nullptr, PluginRender::NapiSetAttraction, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setSurfaceFormat", nullptr, PluginRender::NapiSetSurfaceFormat, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "getSurfaceFormat", nullptr, PluginRender::NapiGetSurfaceFormat, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "setTimeline", nullptr, PluginRender::NapiSetTimeline, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "clearTimeline", nullptr, PluginRender::NapiClearTimeline, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "saveScene", nullptr, PluginRender::NapiSaveScene, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "loadScene", nullptr, PluginRender::NapiLoadScene, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "sampleField", nullptr, PluginRender::NapiSampleField, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "hitTest", nullptr, PluginRender::NapiHitTest, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "captureScene", nullptr, PluginRender::NapiCaptureScene, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "subscribeEvents", nullptr, PluginRender::NapiSubscribeEvents, nullptr, nullptr, nullptr, napi_default, nullptr },
+        { "unsubscribeEvents", nullptr, PluginRender::NapiUnsubscribeEvents, nullptr, nullptr, nullptr, napi_default, nullptr },
     };
 
     NAPI_CALL(env, napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc));
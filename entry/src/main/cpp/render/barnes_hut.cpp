@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "render/barnes_hut.h"
+
+// Below this the walks are cheaper than waking the pool.
+#define BH_PARALLEL_MIN_BODIES 256
+#define BH_BODIES_PER_TASK 32
+// Coincident bodies stop splitting here and share a leaf.
+#define BH_MAX_DEPTH 24
+#define BH_STACK_SIZE (3 * BH_MAX_DEPTH + 4)
+
+// First body count where the single-threaded tree beat the exact sum, per theta (bench:
+// attraction/crossover/theta:*; the highest of repeated runs, since a tie should go to the
+// exact sum). Small thetas open so many cells that at 0.3 the runs ranged from ~400 bodies to
+// past the end of the 512-body scan. Interpolated in between, clamped outside.
+static const float CROSSOVER_THETAS[] = {0.3f, 0.5f, 1.0f};
+static const int32_t CROSSOVER_BODIES[] = {512, 112, 48};
+#define CROSSOVER_POINTS 3
+
+int32_t BarnesHut::ExactMaxBodies(float theta)
+{
+    if (theta <= CROSSOVER_THETAS[0]) {
+        return CROSSOVER_BODIES[0];
+    }
+    for (int32_t i = 1; i < CROSSOVER_POINTS; i++) {
+        if (theta <= CROSSOVER_THETAS[i]) {
+            float t = (theta - CROSSOVER_THETAS[i - 1]) / (CROSSOVER_THETAS[i] - CROSSOVER_THETAS[i - 1]);
+            return (int32_t)(CROSSOVER_BODIES[i - 1] + t * (CROSSOVER_BODIES[i] - CROSSOVER_BODIES[i - 1]));
+        }
+    }
+    return CROSSOVER_BODIES[CROSSOVER_POINTS - 1];
+}
+
+BarnesHut::BarnesHut(int32_t threadCount) : threadCount_(threadCount)
+{
+}
+
+BarnesHut::~BarnesHut()
+{
+    delete pool_;
+}
+
+static inline void AddPull(float dx, float dy, float m, float softening2, float &ax, float &ay)
+{
+    float d2 = dx * dx + dy * dy + softening2;
+    float inv = 1.0f / std::sqrt(d2);
+    float scale = m * inv * inv * inv;
+    ax += dx * scale;
+    ay += dy * scale;
+}
+
+void BarnesHut::Compute(const float *x, const float *y, const float *mass, int32_t count, float strength,
+                        float softening, float *ax, float *ay)
+{
+    if (count <= 0) {
+        return;
+    }
+    int32_t exactMaxBodies = exactMaxBodies_ < 0 ? ExactMaxBodies(theta_) : exactMaxBodies_;
+    if (theta_ <= 0.0f || count < exactMaxBodies) {
+        nodeCount_ = 0;
+        ComputeExact(x, y, mass, count, strength, softening, ax, ay);
+        return;
+    }
+    Build(x, y, mass, count);
+
+    float softening2 = softening * softening;
+    auto walkRange = [&](int32_t begin, int32_t end) {
+        for (int32_t i = begin; i < end; i++) {
+            Walk(i, x[i], y[i], strength, softening2, ax[i], ay[i]);
+        }
+    };
+    if (count < BH_PARALLEL_MIN_BODIES || threadCount_ == 1) {
+        walkRange(0, count);
+        return;
+    }
+    if (!pool_) {
+        pool_ = new ThreadPool(threadCount_);
+    }
+    uint32_t tasks = (uint32_t)((count + BH_BODIES_PER_TASK - 1) / BH_BODIES_PER_TASK);
+    pool_->ParallelFor(tasks, [&](uint32_t task) {
+        int32_t begin = (int32_t)task * BH_BODIES_PER_TASK;
+        walkRange(begin, std::min(count, begin + BH_BODIES_PER_TASK));
+    });
+}
+
+void BarnesHut::ComputeExact(const float *x, const float *y, const float *mass, int32_t count, float strength,
+                             float softening, float *ax, float *ay)
+{
+    float softening2 = softening * softening;
+    for (int32_t i = 0; i < count; i++) {
+        float sumX = 0.0f;
+        float sumY = 0.0f;
+        for (int32_t j = 0; j < count; j++) {
+            if (j != i) {
+                AddPull(x[j] - x[i], y[j] - y[i], mass[j], softening2, sumX, sumY);
+            }
+        }
+        ax[i] = strength * sumX;
+        ay[i] = strength * sumY;
+    }
+}
+
+void BarnesHut::Build(const float *x, const float *y, const float *mass, int32_t count)
+{
+    float minX = x[0];
+    float maxX = x[0];
+    float minY = y[0];
+    float maxY = y[0];
+    for (int32_t i = 1; i < count; i++) {
+        minX = std::min(minX, x[i]);
+        maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]);
+        maxY = std::max(maxY, y[i]);
+    }
+
+    // A quadtree of n bodies needs about 2n nodes unless they cluster; grow once and keep it.
+    size_t reserve = (size_t)count * 4 + 1;
+    if (nodes_.size() < reserve) {
+        nodes_.resize(reserve);
+    }
+    // Padded so bodies on the max edge still fall inside the root.
+    float halfSize = 0.5f * std::max(maxX - minX, maxY - minY) + 1.0f;
+    nodes_[0] = {0.5f * (minX + maxX), 0.5f * (minY + maxY), halfSize, 0.0f, 0.0f, 0.0f, -1, -1};
+    nodeCount_ = 1;
+
+    for (int32_t i = 0; i < count; i++) {
+        Insert(i, x[i], y[i], mass[i]);
+    }
+    for (int32_t n = 0; n < nodeCount_; n++) {
+        Node &node = nodes_[n];
+        if (node.mass > 0.0f) {
+            node.massX /= node.mass;
+            node.massY /= node.mass;
+        }
+    }
+}
+
+void BarnesHut::Insert(int32_t body, float px, float py, float m)
+{
+    int32_t n = 0;
+    for (int32_t depth = 0;; depth++) {
+        if (nodes_[n].firstChild < 0 && nodes_[n].body >= 0 && depth < BH_MAX_DEPTH) {
+            Split(n);
+        }
+        // Split may grow the storage, so take the reference afterwards.
+        Node &node = nodes_[n];
+        node.massX += m * px;
+        node.massY += m * py;
+        node.mass += m;
+        if (node.firstChild < 0) {
+            // An empty leaf takes the body; a full one at max depth is effectively the same point and
+            // just merges the mass.
+            if (node.body < 0) {
+                node.body = body;
+            }
+            return;
+        }
+        int32_t quadrant = (px >= node.centerX ? 1 : 0) | (py >= node.centerY ? 2 : 0);
+        n = node.firstChild + quadrant;
+    }
+}
+
+// Turns a leaf into an internal node and pushes its resident body down one level.
+void BarnesHut::Split(int32_t n)
+{
+    if ((size_t)nodeCount_ + 4 > nodes_.size()) {
+        nodes_.resize(nodes_.size() * 2);
+    }
+    Node &node = nodes_[n];
+    float quarter = 0.5f * node.halfSize;
+    int32_t first = nodeCount_;
+    nodeCount_ += 4;
+    for (int32_t q = 0; q < 4; q++) {
+        float cx = node.centerX + ((q & 1) ? quarter : -quarter);
+        float cy = node.centerY + ((q & 2) ? quarter : -quarter);
+        nodes_[first + q] = {cx, cy, quarter, 0.0f, 0.0f, 0.0f, -1, -1};
+    }
+
+    // The leaf's sums are the resident's alone, so its position can be recovered from them.
+    int32_t resident = node.body;
+    float rx = node.massX / node.mass;
+    float ry = node.massY / node.mass;
+    int32_t quadrant = (rx >= node.centerX ? 1 : 0) | (ry >= node.centerY ? 2 : 0);
+    Node &child = nodes_[first + quadrant];
+    child.massX = node.massX;
+    child.massY = node.massY;
+    child.mass = node.mass;
+    child.body = resident;
+    node.body = -1;
+    node.firstChild = first;
+}
+
+void BarnesHut::Walk(int32_t body, float px, float py, float strength, float softening2, float &ax, float &ay) const
+{
+    float theta2 = theta_ * theta_;
+    float sumX = 0.0f;
+    float sumY = 0.0f;
+    // Depth-first: at most three pending siblings per level plus the current path.
+    int32_t stack[BH_STACK_SIZE];
+    int32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node &node = nodes_[stack[--top]];
+        if (node.mass <= 0.0f) {
+            continue;
+        }
+        float dx = node.massX - px;
+        float dy = node.massY - py;
+        if (node.firstChild < 0) {
+            if (node.body != body) {
+                AddPull(dx, dy, node.mass, softening2, sumX, sumY);
+            }
+            continue;
+        }
+        float width = 2.0f * node.halfSize;
+        if (width * width < theta2 * (dx * dx + dy * dy)) {
+            AddPull(dx, dy, node.mass, softening2, sumX, sumY);
+            continue;
+        }
+        for (int32_t q = 0; q < 4; q++) {
+            stack[top++] = node.firstChild + q;
+        }
+    }
+    ax = strength * sumX;
+    ay = strength * sumY;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BARNES_HUT_H
+#define BARNES_HUT_H
+
+#include <cstdint>
+#include <vector>
+#include "render/thread_pool.h"
+
+#define BH_DEFAULT_THETA 0.5f
+#define BH_MAX_THETA 2.0f
+
+/**
+ * Softened inverse-square attraction between n bodies in O(n log n).
+ * Compute() rebuilds a quadtree over the bodies into node storage that is kept
+ * between calls, then walks it once per body: a cell whose width over distance
+ * is below the opening angle theta acts as a single mass at its center of mass.
+ * With theta = 0, or below the body count where the tree starts to beat the
+ * exact sum at this theta (ExactMaxBodies), it computes the exact sum instead.
+ * Above BH_PARALLEL_MIN_BODIES the per-body walks run on a ThreadPool, started
+ * the first time a call needs it.
+ */
+class BarnesHut {
+public:
+    // threadCount <= 0 picks hardware_concurrency(); 1 keeps every call on the caller's thread.
+    explicit BarnesHut(int32_t threadCount = 0);
+    ~BarnesHut();
+
+    void SetTheta(float theta) { theta_ = theta; }
+    float Theta() const { return theta_; }
+    // Compute() takes the exact sum below this body count; 0 always builds the tree,
+    // -1 (the default) follows ExactMaxBodies(theta).
+    void SetExactMaxBodies(int32_t count) { exactMaxBodies_ = count; }
+    // The measured single-thread crossover: below it, the exact sum is the faster one.
+    static int32_t ExactMaxBodies(float theta);
+    // Writes the acceleration on each body: strength * sum m_j * d / (|d|^2 + softening^2)^1.5.
+    void Compute(const float *x, const float *y, const float *mass, int32_t count, float strength, float softening,
+                 float *ax, float *ay);
+    // The O(n^2) sum: the small-n path of Compute() and the accuracy reference.
+    static void ComputeExact(const float *x, const float *y, const float *mass, int32_t count, float strength,
+                             float softening, float *ax, float *ay);
+    // Nodes of the last tree built; 0 when the last call took the exact sum.
+    int32_t NodeCount() const { return nodeCount_; }
+
+private:
+    struct Node {
+        float centerX, centerY, halfSize;
+        // Mass-weighted position sums until Build() finishes, then the center of mass.
+        float massX, massY, mass;
+        // Index of the first of four consecutive children, or -1 for a leaf.
+        int32_t firstChild;
+        // Body held by a leaf, or -1.
+        int32_t body;
+    };
+
+    void Build(const float *x, const float *y, const float *mass, int32_t count);
+    void Insert(int32_t body, float px, float py, float m);
+    void Split(int32_t node);
+    void Walk(int32_t body, float px, float py, float strength, float softening2, float &ax, float &ay) const;
+
+    float theta_ = BH_DEFAULT_THETA;
+    int32_t exactMaxBodies_ = -1;
+    int32_t threadCount_;
+    ThreadPool *pool_ = nullptr;
+    // Pooled: nodeCount_ resets every build, the vector only grows.
+    std::vector<Node> nodes_;
+    int32_t nodeCount_ = 0;
+};
+
+#endif // BARNES_HUT_H
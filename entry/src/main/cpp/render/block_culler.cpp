@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include "render/block_culler.h"
+
+// Same clamp as the shader's "if(distSquared < 0.001)".
+#define MIN_DIST_SQUARED 0.001f
+// Pixel centers sit half a pixel inside the block; one more pixel covers the AA ramp.
+#define CULL_BLOCK_PADDING 1.0f
+
+void BlockCuller::Classify(const float *positions, const float *weights, int32_t count, const IsoLevels &levels,
+                           int32_t w, int32_t h)
+{
+    width_ = w;
+    height_ = h;
+    cols_ = (w + CULL_BLOCK_SIZE - 1) / CULL_BLOCK_SIZE;
+    rows_ = (h + CULL_BLOCK_SIZE - 1) / CULL_BLOCK_SIZE;
+    // Only reallocates when the surface grows.
+    classes_.resize((size_t)cols_ * rows_);
+
+    for (int32_t by = 0; by < rows_; by++) {
+        float minY = (float)(by * CULL_BLOCK_SIZE) - CULL_BLOCK_PADDING;
+        float maxY = (float)std::min((by + 1) * CULL_BLOCK_SIZE, h) + CULL_BLOCK_PADDING;
+        for (int32_t bx = 0; bx < cols_; bx++) {
+            float minX = (float)(bx * CULL_BLOCK_SIZE) - CULL_BLOCK_PADDING;
+            float maxX = (float)std::min((bx + 1) * CULL_BLOCK_SIZE, w) + CULL_BLOCK_PADDING;
+            float lo = 0.0f;
+            float hi = 0.0f;
+            for (int32_t i = 0; i < count; i++) {
+                float px = positions[2 * i];
+                float py = positions[2 * i + 1];
+                float nearX = std::max(0.0f, std::max(minX - px, px - maxX));
+                float nearY = std::max(0.0f, std::max(minY - py, py - maxY));
+                float farX = std::max(px - minX, maxX - px);
+                float farY = std::max(py - minY, maxY - py);
+                hi += weights[i] / std::max(nearX * nearX + nearY * nearY, MIN_DIST_SQUARED);
+                lo += weights[i] / std::max(farX * farX + farY * farY, MIN_DIST_SQUARED);
+            }
+
+            BlockClass blockClass = BLOCK_EDGE;
+            if (lo >= levels.inside) {
+                blockClass = BLOCK_INSIDE;
+            } else if (hi < levels.halo) {
+                blockClass = BLOCK_OUTSIDE;
+            } else if (lo >= levels.halo && hi < levels.inside) {
+                blockClass = BLOCK_HALO;
+            }
+            classes_[by * cols_ + bx] = blockClass;
+        }
+    }
+}
+
+void BlockCuller::BuildTriangles()
+{
+    for (auto &triangles : triangles_) {
+        triangles.clear();
+    }
+    for (int32_t by = 0; by < rows_; by++) {
+        // Screen y grows downwards, clip y upwards.
+        float top = 1.0f - 2.0f * (float)(by * CULL_BLOCK_SIZE) / (float)height_;
+        float bottom = 1.0f - 2.0f * (float)std::min((by + 1) * CULL_BLOCK_SIZE, height_) / (float)height_;
+        for (int32_t bx = 0; bx < cols_; bx++) {
+            float left = 2.0f * (float)(bx * CULL_BLOCK_SIZE) / (float)width_ - 1.0f;
+            float right = 2.0f * (float)std::min((bx + 1) * CULL_BLOCK_SIZE, width_) / (float)width_ - 1.0f;
+            std::vector<float> &triangles = triangles_[classes_[by * cols_ + bx]];
+            const float quad[12] = {left, bottom, right, bottom, left, top, left, top, right, bottom, right, top};
+            triangles.insert(triangles.end(), quad, quad + 12);
+        }
+    }
+}
+
+float BlockCuller::SkippedFraction() const
+{
+    if (width_ <= 0 || height_ <= 0) {
+        return 0.0f;
+    }
+    int64_t edgePixels = 0;
+    for (int32_t by = 0; by < rows_; by++) {
+        int32_t blockH = std::min((by + 1) * CULL_BLOCK_SIZE, height_) - by * CULL_BLOCK_SIZE;
+        for (int32_t bx = 0; bx < cols_; bx++) {
+            if (classes_[by * cols_ + bx] == BLOCK_EDGE) {
+                edgePixels += (int64_t)(std::min((bx + 1) * CULL_BLOCK_SIZE, width_) - bx * CULL_BLOCK_SIZE) * blockH;
+            }
+        }
+    }
+    return 1.0f - (float)edgePixels / ((float)width_ * (float)height_);
+}
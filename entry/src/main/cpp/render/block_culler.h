@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BLOCK_CULLER_H
+#define BLOCK_CULLER_H
+
+#include <cstdint>
+#include <vector>
+#include "render/iso_levels.h"
+
+// Edge of a culling block in pixels.
+#define CULL_BLOCK_SIZE 16
+
+enum BlockClass : uint8_t {
+    BLOCK_OUTSIDE = 0,
+    BLOCK_HALO = 1,
+    BLOCK_INSIDE = 2,
+    // An isoline may cross the block; it needs the per-pixel field.
+    BLOCK_EDGE = 3
+};
+
+/**
+ * Coarse pass for the field renderers.
+ * For each CULL_BLOCK_SIZE block, every ball's nearest and farthest distance to
+ * the block gives a conservative lower and upper bound of the field over it.
+ * Blocks whose bounds sit entirely inside one band get a constant color; only
+ * BLOCK_EDGE blocks run the per-pixel loop. The block is padded by a pixel and
+ * a half before bounding, so the one-pixel anti-aliasing ramp of ISO_SHADE_GLSL
+ * never reaches a constant block either.
+ */
+class BlockCuller {
+public:
+    // weights holds each ball's strength * radius^2, as in g_metaballWeights.
+    void Classify(const float *positions, const float *weights, int32_t count, const IsoLevels &levels, int32_t w,
+                  int32_t h);
+    // Fills Triangles() from the last Classify; only the GL path needs it.
+    void BuildTriangles();
+
+    int32_t Cols() const { return cols_; }
+    int32_t Rows() const { return rows_; }
+    BlockClass At(int32_t bx, int32_t by) const { return (BlockClass)classes_[by * cols_ + bx]; }
+    // Clip-space vertices, six per block of the class, for glDrawArrays(GL_TRIANGLES).
+    const std::vector<float> &Triangles(BlockClass blockClass) const { return triangles_[blockClass]; }
+    // Share of the frame's pixels that skip the per-pixel loop.
+    float SkippedFraction() const;
+
+private:
+    int32_t width_ = 0;
+    int32_t height_ = 0;
+    int32_t cols_ = 0;
+    int32_t rows_ = 0;
+    std::vector<uint8_t> classes_;
+    std::vector<float> triangles_[4];
+};
+
+#endif // BLOCK_CULLER_H
@@ -14,10 +14,17 @@
  */
 
 #include <hilog/log.h>
-#include <random>
-#include <cmath>
-#include <vector>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <native_window/external_window.h>
 #include "render/egl_core_shader.h"
+#include "render/event_channel.h"
+#include "render/metaball_scene.h"
+#include "render/soft_core.h"
+#include "render/field_cache.h"
+#include "render/iso_palette.h"
+#include "render/surface_format.h"
 #include "common/native_common.h"
 
 const char *METABALL_SYNC_NAME = "metaballVSync";
@@ -30,9 +37,6 @@ const char *METABALL_SYNC_NAME = "metaballVSync";
 #define EGL_GL_COLORSPACE_SRGB_KHR 0x3089
 #endif
 
-#define MAX_METABALLS 100
-#define PI 3.1416f
-
 char g_vertexShader[] = "#version 300 es\n"
                         "layout(location = 0) in vec4 a_position;\n"
                         "void main()\n"
@@ -43,121 +47,49 @@ char g_vertexShader[] = "#version 300 es\n"
 char g_fragmentShader[] = "#version 300 es\n"
                           "precision highp float;\n"
                           "out vec4 fragColor;\n"
-                          "uniform vec2 metaballArray[100];\n"
+                          // Per ball: center x, center y, strength * radius^2 (float bits) and RGBA8 tint.
+                          "uniform highp uvec4 metaballArray[100];\n"
                           "uniform int numMetaballs;\n"
                           "uniform float screenHeight;\n"
-                          "uniform float metaballRadiusSquared;\n"
+                          "uniform bool tinted;\n"
+                          "uniform vec2 pixelScale;\n"
+                          ISO_SHADE_GLSL
+                          ISO_TINT_GLSL
                           "void main()\n"
                           "{\n"
-                          "   vec2 pixelCoord = gl_FragCoord.xy;\n"
+                          "   vec2 pixelCoord = gl_FragCoord.xy * pixelScale;\n"
                           "   pixelCoord.y = screenHeight - pixelCoord.y;\n"
                           "   float sum = 0.0;\n"
+                          "   vec3 tint = vec3(0.0);\n"
                           "   for(int i = 0; i < numMetaballs; i++) {\n"
-                          "       vec2 diff = metaballArray[i] - pixelCoord;\n"
+                          "       highp uvec4 ball = metaballArray[i];\n"
+                          "       vec2 diff = uintBitsToFloat(ball.xy) - pixelCoord;\n"
                           "       float distSquared = dot(diff, diff);\n"
                           "       if(distSquared < 0.001) distSquared = 0.001;\n"
-                          "       sum += metaballRadiusSquared / distSquared;\n"
-                          "   }\n"
-                          "   vec3 color = vec3(0.0);\n"
-                          "   if(sum >= 1.0) {\n"
-                          "       color = vec3(0.1, 0.8, 0.9);\n"
-                          "   } else if(sum >= 0.5) {\n"
-                          "       color = vec3(0.05, 0.4, 0.6);\n"
+                          "       float f = uintBitsToFloat(ball.z) / distSquared;\n"
+                          "       sum += f;\n"
+                          "       if(tinted) tint += f * unpackTint(ball.w);\n"
                           "   }\n"
-                          "   fragColor = vec4(color, 1.0);\n"
+                          "   vec3 color = shadeField(sum);\n"
+                          "   if(tinted) color *= tint / max(sum, 1e-6);\n"
+                          "   fragColor = vec4(encodeOutput(color), 1.0);\n"
                           "}\n";
 
-struct Metaball {
-    float x, y;
-    float dirX, dirY;
-    float radius;
-    bool active;
-};
-
-std::vector<Metaball> g_metaballs;
-float g_metaballPositions[2 * MAX_METABALLS] = {0};
-std::mt19937 g_rng;
-
-void InitMetaballs()
-{
-    g_metaballs.clear();
-    g_rng.seed(std::random_device{}());
-    LOGI("Metaballs initialized");
-}
-
-void AddMetaball(float x, float y, float screenWidth, float screenHeight, float radius)
-{
-    if (g_metaballs.size() >= MAX_METABALLS) {
-        LOGW("Maximum metaballs reached");
-        return;
-    }
-
-    std::uniform_real_distribution<float> angleDist(0, 2.0f * PI);
-    float angle = angleDist(g_rng);
-
-    Metaball mb;
-    mb.x = x;
-    mb.y = y;
-    mb.dirX = std::cos(angle);
-    mb.dirY = std::sin(angle);
-    mb.radius = radius;
-    mb.active = true;
-
-    g_metaballs.push_back(mb);
-    LOGI("Metaball added at (%{public}f, %{public}f), total: %{public}zu", x, y, g_metaballs.size());
-}
-
-void UpdateMetaballs(float screenWidth, float screenHeight, float speed)
-{
-    for (size_t i = 0; i < g_metaballs.size(); i++) {
-        if (!g_metaballs[i].active)
-            continue;
-
-        g_metaballs[i].x += g_metaballs[i].dirX * speed;
-        g_metaballs[i].y += g_metaballs[i].dirY * speed;
-
-        g_metaballPositions[2 * i] = g_metaballs[i].x;
-        g_metaballPositions[2 * i + 1] = g_metaballs[i].y;
-
-        if (g_metaballs[i].x >= screenWidth || g_metaballs[i].x <= 0) {
-            g_metaballs[i].dirX *= -1.0f;
-        }
-        if (g_metaballs[i].y >= screenHeight || g_metaballs[i].y <= 0) {
-            g_metaballs[i].dirY *= -1.0f;
-        }
-    }
-}
+// Constant-color pass for blocks the culler proved to lie inside one band.
+char g_flatFragmentShader[] = "#version 300 es\n"
+                              "precision mediump float;\n"
+                              "out vec4 fragColor;\n"
+                              "uniform vec3 flatColor;\n"
+                              "void main()\n"
+                              "{\n"
+                              "   fragColor = vec4(flatColor, 1.0);\n"
+                              "}\n";
 
 struct SyncParam {
     EGLCore *eglCore = nullptr;
     void *window = nullptr;
 };
 
-static EGLConfig getConfig(EGLDisplay eglDisplay)
-{
-    int attribList[] = {EGL_SURFACE_TYPE,
-                        EGL_WINDOW_BIT,
-                        EGL_RED_SIZE,
-                        8,
-                        EGL_GREEN_SIZE,
-                        8,
-                        EGL_BLUE_SIZE,
-                        8,
-                        EGL_ALPHA_SIZE,
-                        8,
-                        EGL_RENDERABLE_TYPE,
-                        EGL_OPENGL_ES3_BIT,
-                        EGL_NONE};
-    EGLConfig configs = NULL;
-    int configsNum;
-    if (!eglChooseConfig(eglDisplay, attribList, &configs, 1, &configsNum)) {
-        LOGE("eglChooseConfig ERROR");
-        return NULL;
-    }
-    return configs;
-}
-
-
 void EGLCore::OnSurfaceCreated(void *window, int w, int h)
 {
     LOGD("EGLCore::OnSurfaceCreated w=%{public}d, h=%{public}d", w, h);
@@ -165,6 +97,10 @@ void EGLCore::OnSurfaceCreated(void *window, int w, int h)
     height_ = h;
 
     InitMetaballs();
+    simClock_.Reset();
+    lastFrameTimestamp_ = 0;
+    lastPostedBallCount_ = -1;
+    g_renderEvents.PostSurface(SURFACE_CREATED, w, h);
 
     SyncParam *param = new SyncParam();
     param->eglCore = this;
@@ -187,31 +123,27 @@ void EGLCore::OnSurfaceCreated(void *window, int w, int h)
             if (!eglCore || !window) return;
 
             eglCore->mEglWindow = reinterpret_cast<EGLNativeWindowType>(window);
+#ifdef METABALLS_SOFTWARE_RENDER
+            eglCore->FallbackToSoftware(timestamp);
+            return;
+#endif
             eglCore->mEGLDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
 
             if (eglCore->mEGLDisplay == EGL_NO_DISPLAY) {
                 LOGE("Unable to get EGL display");
+                eglCore->FallbackToSoftware(timestamp);
                 return;
             }
 
             EGLint eglMajVers, eglMinVers;
             if (!eglInitialize(eglCore->mEGLDisplay, &eglMajVers, &eglMinVers)) {
                 LOGE("Unable to initialize display");
+                eglCore->FallbackToSoftware(timestamp);
                 return;
             }
 
-            eglCore->mEGLConfig = getConfig(eglCore->mEGLDisplay);
-            if (!eglCore->mEGLConfig) {
-                LOGE("Config ERROR");
-                return;
-            }
-
-            EGLint winAttribs[] = {EGL_GL_COLORSPACE_KHR, EGL_GL_COLORSPACE_SRGB_KHR, EGL_NONE};
-            eglCore->mEGLSurface =
-                eglCreateWindowSurface(eglCore->mEGLDisplay, eglCore->mEGLConfig, eglCore->mEglWindow, winAttribs);
-
-            if (!eglCore->mEGLSurface) {
-                LOGE("eglSurface is null");
+            if (!eglCore->CreateWindowSurface()) {
+                eglCore->FallbackToSoftware(timestamp);
                 return;
             }
 
@@ -222,51 +154,240 @@ void EGLCore::OnSurfaceCreated(void *window, int w, int h)
             if (!eglMakeCurrent(eglCore->mEGLDisplay, eglCore->mEGLSurface, eglCore->mEGLSurface,
                                 eglCore->mEGLContext)) {
                 LOGE("eglMakeCurrent error = %{public}d", eglGetError());
+                eglCore->FallbackToSoftware(timestamp);
                 return;
             }
 
-            eglCore->mProgramHandle = eglCore->CreateProgram(g_vertexShader, g_fragmentShader);
-            if (!eglCore->mProgramHandle) {
-                LOGE("Could not create program");
+            if (!eglCore->InitGL()) {
+                eglCore->FallbackToSoftware(timestamp);
                 return;
             }
 
-            float metaballRadius = 25.0f;
-            eglCore->metaballRadiusSquared_ = metaballRadius * metaballRadius;
-
-            glUseProgram(eglCore->mProgramHandle);
-            GLint screenHeightLoc = glGetUniformLocation(eglCore->mProgramHandle, "screenHeight");
-            glUniform1f(screenHeightLoc, (float)eglCore->height_);
-            
-            GLint radiusLoc = glGetUniformLocation(eglCore->mProgramHandle, "metaballRadiusSquared");
-            glUniform1f(radiusLoc, eglCore->metaballRadiusSquared_);
-
             LOGI("EGL initialized successfully, starting render loop");
-            eglCore->RenderLoop();
+            eglCore->RenderLoop(timestamp);
         },
         param);
 }
 
 
-void EGLCore::RenderLoop()
+bool EGLCore::CreateWindowSurface()
+{
+    SurfaceRequest request;
+    {
+        std::lock_guard<std::mutex> lock(surfaceMutex_);
+        request = surfaceRequest_;
+    }
+    SurfaceFormat format;
+    mEGLConfig = ChooseSurfaceConfig(mEGLDisplay, EGL_WINDOW_BIT, request, format);
+    if (!mEGLConfig) {
+        LOGE("Config ERROR");
+        return false;
+    }
+    int32_t nativeFormat = SurfaceNativeFormat(format);
+    if (nativeFormat >= 0) {
+        OH_NativeWindow_NativeWindowHandleOpt(reinterpret_cast<OHNativeWindow *>(mEglWindow), SET_FORMAT,
+                                              nativeFormat);
+    }
+
+    // The sRGB colorspace needs 8-bit channels; any other surface gets the encode in the field shaders.
+    const char *extensions = eglQueryString(mEGLDisplay, EGL_EXTENSIONS);
+    bool srgb = request.srgb && format.red == 8 && extensions && strstr(extensions, "EGL_KHR_gl_colorspace");
+    mEGLSurface = EGL_NO_SURFACE;
+    if (srgb) {
+        EGLint winAttribs[] = {EGL_GL_COLORSPACE_KHR, EGL_GL_COLORSPACE_SRGB_KHR, EGL_NONE};
+        mEGLSurface = eglCreateWindowSurface(mEGLDisplay, mEGLConfig, mEglWindow, winAttribs);
+        if (mEGLSurface == EGL_NO_SURFACE) {
+            LOGW("sRGB window surface rejected, encoding in the shader");
+            srgb = false;
+        }
+    }
+    if (mEGLSurface == EGL_NO_SURFACE) {
+        mEGLSurface = eglCreateWindowSurface(mEGLDisplay, mEGLConfig, mEglWindow, nullptr);
+    }
+    if (mEGLSurface == EGL_NO_SURFACE) {
+        LOGE("eglSurface is null");
+        return false;
+    }
+    format.srgb = srgb;
+
+    {
+        std::lock_guard<std::mutex> lock(surfaceMutex_);
+        surfaceFormat_ = format;
+    }
+    LOGI("Window surface R%{public}dG%{public}dB%{public}dA%{public}d, %{public}d samples, %{public}s, "
+         "fallback step %{public}d, ~%{public}lld bytes/frame",
+         format.red, format.green, format.blue, format.alpha, format.samples, srgb ? "sRGB" : "linear",
+         format.fallbackStep, (long long)EstimateFrameBytes(format, width_, height_));
+    return true;
+}
+
+bool EGLCore::InitGL()
+{
+    mProgramHandle = CreateProgram(g_vertexShader, g_fragmentShader);
+    if (!mProgramHandle) {
+        LOGE("Could not create program");
+        return false;
+    }
+
+    // Without it the field pass simply covers every block.
+    flatProgram_ = CreateProgram(g_vertexShader, g_flatFragmentShader);
+    if (!flatProgram_) {
+        LOGW("Could not create flat program, block culling disabled");
+    }
+
+    if (!isoPalette_.Init()) {
+        return false;
+    }
+    isoPalette_.SetSurfaceSrgb(surfaceFormat_.srgb);
+
+    glUseProgram(mProgramHandle);
+    GLint screenHeightLoc = glGetUniformLocation(mProgramHandle, "screenHeight");
+    glUniform1f(screenHeightLoc, (float)height_);
+    return true;
+}
+
+void EGLCore::FallbackToSoftware(long long timestamp)
 {
-    if (!eglMakeCurrent(mEGLDisplay, mEGLSurface, mEGLSurface, mEGLContext)) {
+    LOGW("GLES 3 unavailable, falling back to the software renderer");
+    if (mEGLDisplay != EGL_NO_DISPLAY) {
+        eglMakeCurrent(mEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (mEGLContext != EGL_NO_CONTEXT) {
+            eglDestroyContext(mEGLDisplay, mEGLContext);
+            mEGLContext = EGL_NO_CONTEXT;
+        }
+        // The window can only have one producer, so EGL must let go of it first.
+        if (mEGLSurface != EGL_NO_SURFACE) {
+            eglDestroySurface(mEGLDisplay, mEGLSurface);
+            mEGLSurface = EGL_NO_SURFACE;
+        }
+    }
+
+    {
+        // SoftCore always writes sRGB-encoded RGBA8888.
+        std::lock_guard<std::mutex> lock(surfaceMutex_);
+        surfaceFormat_ = SurfaceFormat();
+    }
+    softCore_ = new SoftCore();
+    softCore_->OnSurfaceCreated(reinterpret_cast<void *>(mEglWindow), width_, height_);
+    RenderLoop(timestamp);
+}
+
+void EGLCore::RenderLoop(long long timestamp)
+{
+    if (!softCore_ && !eglMakeCurrent(mEGLDisplay, mEGLSurface, mEGLSurface, mEGLContext)) {
         LOGE("RenderLoop: eglMakeCurrent error = %{public}d", eglGetError());
         return;
     }
 
-    UpdateMetaballs((float)width_, (float)height_, 2.0f);
+    auto frameStart = std::chrono::steady_clock::now();
+    int numMetaballs;
+    uint32_t revision;
+    IsoLevels isoLevels;
+    int32_t steps;
+    float stepDistance = METABALL_SPEED_PX_PER_SECOND * simClock_.StepSeconds();
+    {
+        std::lock_guard<std::mutex> lock(g_metaballMutex);
+        steps = simClock_.Advance(timestamp);
+        if (!softCore_) {
+            UpdateGpuSimState();
+        }
+        if (gpuSim_.Active()) {
+            // The steps run on the GPU below; here the pool only trades edits and readbacks with it.
+            gpuSim_.ApplyEdits(g_metaballs);
+        } else {
+            float attraction = attractionStrength_.load();
+            attraction_.SetTheta(attractionTheta_.load());
+            for (int32_t i = 0; i < steps; i++) {
+                if (attraction > 0.0f) {
+                    AttractMetaballs(attraction_, attraction, simClock_.StepSeconds());
+                }
+                UpdateMetaballs((float)width_, (float)height_, stepDistance);
+            }
+            // Scripted balls override whatever the free simulation did to them this frame.
+            timeline_.Apply(timestamp, g_metaballs);
+        }
+        PackMetaballPositions(simClock_.Alpha());
+        numMetaballs = (int)g_metaballs.Size();
+        revision = g_metaballs.Revision();
+        isoLevels = g_isoLevels;
+    }
+    fieldIndex_.Publish(g_metaballPositions, g_metaballWeights, numMetaballs, isoLevels);
+
+    if (softCore_) {
+        softCore_->SetIsoLevels(isoLevels);
+        softCore_->SetBlockCulling(blockCullingRequested_.load());
+        softCore_->RenderFrame(g_metaballPositions, g_metaballWeights, g_metaballColors, numMetaballs);
+        PublishFrameEvents(timestamp, frameStart, steps, numMetaballs);
+        RequestNextFrame();
+        return;
+    }
+
+    isoPalette_.SetLevels(isoLevels);
+    isoPalette_.SetAntialias(edgeAntialiasRequested_.load());
+
+    // Culling and the field cache work from CPU positions, which trail the GPU simulation.
+    bool gpuSim = gpuSim_.Active();
+    if (gpuSim) {
+        gpuSim_.Step(numMetaballs, steps, stepDistance, (float)width_, (float)height_);
+        gpuSim_.QueueReadback(revision);
+    }
+
+    PackMetaballUniforms(ballUniforms_, numMetaballs);
+    tinted_ = MetaballsTinted(numMetaballs);
+
+    // The cached field holds the scalar sum only, so tinted scenes take the full pass.
+    UpdateFieldCacheState();
+    bool cached = fieldCache_ && !gpuSim && !tinted_ &&
+                  fieldCache_->Update(g_metaballPositions, g_metaballWeights, numMetaballs, revision);
 
     glViewport(0, 0, width_, height_);
-    glClearColor(0.04f, 0.04f, 0.1f, 1.0f);
+    // The outside band's color, so culled outside blocks need no draw at all.
+    const float *outside = isoPalette_.SurfaceColor(BLOCK_OUTSIDE);
+    glClearColor(outside[0], outside[1], outside[2], 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
-    glUseProgram(mProgramHandle);
 
-    GLint numMetaballsLoc = glGetUniformLocation(mProgramHandle, "numMetaballs");
-    glUniform1i(numMetaballsLoc, (int)g_metaballs.size());
+    if (cached) {
+        fieldCache_->Draw(isoPalette_);
+    } else if (flatProgram_ && blockCullingRequested_.load() && !gpuSim) {
+        DrawFieldCulled(numMetaballs, isoLevels);
+    } else {
+        DrawField(numMetaballs, 1.0f, 1.0f);
+    }
+
+    // No glFinish here: eglSwapBuffers flushes, and a full pipeline drain only adds latency.
+    eglSwapBuffers(mEGLDisplay, mEGLSurface);
+
+    // Captures go to their own FBOs and are read back through PBOs. Queued behind the swap,
+    // their draws never delay the frame on screen.
+    frameCapture_.Process([this, numMetaballs](int32_t w, int32_t h) {
+        // Capture targets are always sRGB, whatever the window surface is.
+        isoPalette_.SetSurfaceSrgb(true);
+        DrawField(numMetaballs, (float)width_ / (float)w, (float)height_ / (float)h);
+        isoPalette_.SetSurfaceSrgb(surfaceFormat_.srgb);
+    });
+
+    PublishFrameEvents(timestamp, frameStart, steps, numMetaballs);
+    RequestNextFrame();
+}
+
+void EGLCore::PublishFrameEvents(long long timestamp, std::chrono::steady_clock::time_point frameStart, int32_t steps,
+                                 int numMetaballs)
+{
+    // Ball count changes from any source (touch, NAPI, loadScene) surface here once per frame.
+    if (numMetaballs != lastPostedBallCount_) {
+        g_renderEvents.PostBallCount(numMetaballs);
+        lastPostedBallCount_ = numMetaballs;
+    }
+    double intervalMs = lastFrameTimestamp_ ? (double)(timestamp - lastFrameTimestamp_) / 1e6 : 0.0;
+    double cpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+    g_renderEvents.PostFrame(intervalMs, cpuMs, steps);
+    lastFrameTimestamp_ = timestamp;
+    g_renderEvents.Flush();
+}
 
-    GLint metaballArrayLoc = glGetUniformLocation(mProgramHandle, "metaballArray");
-    glUniform2fv(metaballArrayLoc, MAX_METABALLS, g_metaballPositions);
+void EGLCore::DrawField(int numMetaballs, float scaleX, float scaleY)
+{
+    UseFieldProgram(numMetaballs, scaleX, scaleY);
 
     GLfloat vertices[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
 
@@ -274,24 +395,297 @@ void EGLCore::RenderLoop()
     glEnableVertexAttribArray(0);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glDisableVertexAttribArray(0);
+}
 
-    glFlush();
-    glFinish();
-    eglSwapBuffers(mEGLDisplay, mEGLSurface);
+void EGLCore::DrawFieldCulled(int numMetaballs, const IsoLevels &isoLevels)
+{
+    blockCuller_.Classify(g_metaballPositions, g_metaballWeights, numMetaballs, isoLevels, width_, height_);
+    blockCuller_.BuildTriangles();
+
+    auto drawBlocks = [this](BlockClass blockClass) {
+        const std::vector<float> &triangles = blockCuller_.Triangles(blockClass);
+        if (!triangles.empty()) {
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, triangles.data());
+            glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(triangles.size() / 2));
+        }
+    };
+
+    glEnableVertexAttribArray(0);
+    // A tint varies inside a band, so tinted scenes keep only the outside blocks flat.
+    if (!tinted_) {
+        glUseProgram(flatProgram_);
+        GLint flatColorLoc = glGetUniformLocation(flatProgram_, "flatColor");
+        for (BlockClass blockClass : {BLOCK_HALO, BLOCK_INSIDE}) {
+            glUniform3fv(flatColorLoc, 1, isoPalette_.SurfaceColor(blockClass));
+            drawBlocks(blockClass);
+        }
+    }
 
+    // Only blocks an isoline may cross pay for the per-pixel loop.
+    UseFieldProgram(numMetaballs, 1.0f, 1.0f);
+    drawBlocks(BLOCK_EDGE);
+    if (tinted_) {
+        drawBlocks(BLOCK_HALO);
+        drawBlocks(BLOCK_INSIDE);
+    }
+    glDisableVertexAttribArray(0);
+}
+
+void EGLCore::UseFieldProgram(int numMetaballs, float scaleX, float scaleY)
+{
+    if (gpuSim_.Active()) {
+        gpuSim_.UseFieldProgram(numMetaballs, simClock_.Alpha(), scaleX, scaleY, tinted_, (float)height_,
+                                isoPalette_);
+        return;
+    }
+
+    glUseProgram(mProgramHandle);
+
+    GLint numMetaballsLoc = glGetUniformLocation(mProgramHandle, "numMetaballs");
+    glUniform1i(numMetaballsLoc, numMetaballs);
+
+    // Only the live balls: 16 bytes each instead of the whole array.
+    if (numMetaballs > 0) {
+        GLint metaballArrayLoc = glGetUniformLocation(mProgramHandle, "metaballArray");
+        glUniform4uiv(metaballArrayLoc, numMetaballs, ballUniforms_);
+    }
+    glUniform1i(glGetUniformLocation(mProgramHandle, "tinted"), tinted_ ? 1 : 0);
+
+    // Maps the target's pixels onto screen pixels; (1, 1) except for scaled captures.
+    GLint pixelScaleLoc = glGetUniformLocation(mProgramHandle, "pixelScale");
+    glUniform2f(pixelScaleLoc, scaleX, scaleY);
+
+    isoPalette_.Apply(mProgramHandle);
+}
+
+void EGLCore::RequestNextFrame()
+{
     OH_NativeVSync_RequestFrame(
-        mVsync, [](long long timestamp, void *data) { (reinterpret_cast<EGLCore *>(data))->RenderLoop(); },
+        mVsync,
+        [](long long timestamp, void *data) { (reinterpret_cast<EGLCore *>(data))->RenderLoop(timestamp); },
         (void *)this);
 }
 
-void EGLCore::AddMetaballAt(float x, float y)
+void EGLCore::SetIncrementalField(bool enabled)
+{
+    incrementalFieldRequested_.store(enabled);
+    LOGI("Incremental field %{public}s", enabled ? "requested" : "disabled");
+}
+
+void EGLCore::SetGpuSimulation(bool enabled)
+{
+    gpuSimulationRequested_.store(enabled);
+    LOGI("GPU simulation %{public}s", enabled ? "requested" : "disabled");
+}
+
+bool EGLCore::SetIsoLevels(float halo, float inside)
+{
+    IsoLevels levels;
+    levels.halo = halo;
+    levels.inside = inside;
+    if (!levels.Valid()) {
+        LOGW("SetIsoLevels: rejected halo=%{public}f inside=%{public}f", halo, inside);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_metaballMutex);
+    g_isoLevels = levels;
+    return true;
+}
+
+bool EGLCore::SetSurfaceFormat(int32_t profile, bool srgb, int32_t samples)
+{
+    SurfaceRequest request;
+    request.profile = (SurfaceProfile)profile;
+    request.srgb = srgb;
+    request.samples = samples;
+    if (!request.Valid()) {
+        LOGE("SetSurfaceFormat: invalid profile %{public}d or samples %{public}d", profile, samples);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(surfaceMutex_);
+    surfaceRequest_ = request;
+    LOGI("Surface format %{public}s%{public}s x%{public}d requested", SurfaceProfileName(request.profile),
+         srgb ? " sRGB" : "", samples);
+    return true;
+}
+
+SurfaceFormat EGLCore::GetSurfaceFormat()
+{
+    std::lock_guard<std::mutex> lock(surfaceMutex_);
+    return surfaceFormat_;
+}
+
+bool EGLCore::SetAttraction(float strength, float theta)
+{
+    if (!(strength >= 0.0f && strength <= METABALL_MAX_ATTRACTION) || !(theta >= 0.0f && theta <= BH_MAX_THETA)) {
+        LOGE("SetAttraction: invalid strength %{public}f or theta %{public}f", strength, theta);
+        return false;
+    }
+    attractionTheta_.store(theta);
+    attractionStrength_.store(strength);
+    LOGI("Attraction strength %{public}f, theta %{public}f", strength, theta);
+    return true;
+}
+
+bool EGLCore::LoadTimeline(const MetaballHandle *handles, int32_t trackCount, const float *keyframes,
+                           int32_t keyCount, bool loop)
+{
+    return timeline_.Load(handles, trackCount, keyframes, keyCount, loop);
+}
+
+void EGLCore::ClearTimeline()
+{
+    timeline_.Clear();
+    LOGI("Timeline cleared");
+}
+
+void EGLCore::SetBlockCulling(bool enabled)
+{
+    blockCullingRequested_.store(enabled);
+    LOGI("Block culling %{public}s", enabled ? "enabled" : "disabled");
+}
+
+void EGLCore::SetEdgeAntialiasing(bool enabled)
 {
-    AddMetaball(x, y, (float)width_, (float)height_, 25.0f);
+    edgeAntialiasRequested_.store(enabled);
+    LOGI("Edge antialiasing %{public}s", enabled ? "enabled" : "disabled");
+}
+
+void EGLCore::UpdateFieldCacheState()
+{
+    bool requested = incrementalFieldRequested_.load();
+    if (requested && !fieldCache_) {
+        fieldCache_ = new FieldCache();
+        if (!fieldCache_->Init(width_, height_)) {
+            delete fieldCache_;
+            fieldCache_ = nullptr;
+            incrementalFieldRequested_.store(false);
+        }
+    } else if (!requested && fieldCache_) {
+        fieldCache_->Release();
+        delete fieldCache_;
+        fieldCache_ = nullptr;
+    } else if (fieldCache_) {
+        fieldCache_->Resize(width_, height_);
+    }
+}
+
+// Called with g_metaballMutex held: both transitions move the ball state between the pool and the GPU.
+void EGLCore::UpdateGpuSimState()
+{
+    bool requested = gpuSimulationRequested_.load();
+    if (requested && !gpuSim_.Active()) {
+        if (!gpuSim_.Init(g_metaballs)) {
+            gpuSimulationRequested_.store(false);
+        }
+    } else if (!requested && gpuSim_.Active()) {
+        gpuSim_.Release(g_metaballs);
+    }
+}
+
+bool EGLCore::CaptureScene(int32_t width, int32_t height, napi_threadsafe_function tsfn)
+{
+    if (softCore_) {
+        LOGW("CaptureScene: not available with the software renderer");
+        return false;
+    }
+    return frameCapture_.Request(width, height, tsfn);
+}
+
+float EGLCore::SampleField(float x, float y)
+{
+    return fieldIndex_.Sample(x, y);
+}
+
+void EGLCore::HitTest(const float *points, size_t pointCount, uint8_t *levels)
+{
+    fieldIndex_.HitTest(points, pointCount, levels);
+}
+
+MetaballHandle EGLCore::AddMetaballAt(float x, float y)
+{
+    std::lock_guard<std::mutex> lock(g_metaballMutex);
+    MetaballHandle handle = AddMetaballLocked(x, y, (float)width_, (float)height_, METABALL_DEFAULT_RADIUS);
+    gpuSim_.LogAdd(g_metaballs, handle);
+    return handle;
+}
+
+bool EGLCore::RemoveMetaball(MetaballHandle handle)
+{
+    std::lock_guard<std::mutex> lock(g_metaballMutex);
+    gpuSim_.LogRemove(g_metaballs, handle);
+    return g_metaballs.Remove(handle);
+}
+
+bool EGLCore::MoveMetaball(MetaballHandle handle, float x, float y)
+{
+    std::lock_guard<std::mutex> lock(g_metaballMutex);
+    Metaball *mb = g_metaballs.Get(handle);
+    if (!mb) {
+        return false;
+    }
+    // Teleport: no interpolation streak from the old position.
+    mb->x = x;
+    mb->y = y;
+    mb->prevX = x;
+    mb->prevY = y;
+    gpuSim_.LogMove(g_metaballs, handle);
+    return true;
+}
+
+bool EGLCore::SetMetaballRadius(MetaballHandle handle, float radius)
+{
+    if (!(radius >= METABALL_MIN_RADIUS && radius <= METABALL_MAX_RADIUS)) {
+        LOGE("SetMetaballRadius: invalid radius %{public}f", radius);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_metaballMutex);
+    Metaball *mb = g_metaballs.Get(handle);
+    if (!mb) {
+        return false;
+    }
+    mb->radius = radius;
+    gpuSim_.LogStyle(g_metaballs, handle);
+    return true;
+}
+
+bool EGLCore::SetMetaballStrength(MetaballHandle handle, float strength)
+{
+    if (!(strength >= 0.0f && strength <= METABALL_MAX_STRENGTH)) {
+        LOGE("SetMetaballStrength: invalid strength %{public}f", strength);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_metaballMutex);
+    Metaball *mb = g_metaballs.Get(handle);
+    if (!mb) {
+        return false;
+    }
+    mb->strength = strength;
+    gpuSim_.LogStyle(g_metaballs, handle);
+    return true;
+}
+
+bool EGLCore::SetMetaballColor(MetaballHandle handle, uint32_t rgb)
+{
+    if (rgb > 0xFFFFFFu) {
+        LOGE("SetMetaballColor: invalid color 0x%{public}x", rgb);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_metaballMutex);
+    Metaball *mb = g_metaballs.Get(handle);
+    if (!mb) {
+        return false;
+    }
+    // 0xRRGGBB from JS to RGBA8 memory order.
+    mb->color = ((rgb >> 16) & 0xFFu) | (rgb & 0xFF00u) | ((rgb & 0xFFu) << 16) | 0xFF000000u;
+    gpuSim_.LogStyle(g_metaballs, handle);
+    return true;
 }
 
 void EGLCore::ClearAllMetaballs()
 {
-    g_metaballs.clear();
+    std::lock_guard<std::mutex> lock(g_metaballMutex);
+    g_metaballs.Clear();
     LOGI("All metaballs cleared");
 }
 
@@ -368,6 +762,26 @@ void EGLCore::OnSurfaceDestroyed()
         OH_NativeVSync_Destroy(mVsync);
         mVsync = nullptr;
     }
+    // No frame flushes after this one; the channel sends surface changes even past a queued batch.
+    g_renderEvents.PostSurface(SURFACE_DESTROYED, width_, height_);
+    g_renderEvents.Flush();
+    // Runs without the render thread's context current, so captures are only forgotten and rejected.
+    frameCapture_.Abandon();
+    isoPalette_.Abandon();
+    if (fieldCache_) {
+        // GL objects die with the context below; only the bookkeeping needs freeing.
+        delete fieldCache_;
+        fieldCache_ = nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_metaballMutex);
+        gpuSim_.Abandon();
+    }
+    if (softCore_) {
+        softCore_->OnSurfaceDestroyed();
+        delete softCore_;
+        softCore_ = nullptr;
+    }
     if (mEGLContext != EGL_NO_CONTEXT) {
         eglDestroyContext(mEGLDisplay, mEGLContext);
         mEGLContext = EGL_NO_CONTEXT;
@@ -382,4 +796,8 @@ void EGLCore::OnSurfaceChanged(void *window, int32_t w, int32_t h)
 {
     width_ = w;
     height_ = h;
+    g_renderEvents.PostSurface(SURFACE_CHANGED, w, h);
+    if (softCore_) {
+        softCore_->OnSurfaceChanged(window, w, h);
+    }
 }
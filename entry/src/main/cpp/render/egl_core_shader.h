@@ -16,10 +16,26 @@
 #ifndef NATIVE_XCOMPONENT_PLUGIN_RENDER_H
 #define NATIVE_XCOMPONENT_PLUGIN_RENDER_H
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <string>
 #include <EGL/egl.h>
 #include <GLES3/gl3.h>
 #include <native_vsync/native_vsync.h>
+#include "render/barnes_hut.h"
+#include "render/block_culler.h"
+#include "render/field_query.h"
+#include "render/frame_capture.h"
+#include "render/gpu_sim.h"
+#include "render/iso_palette.h"
+#include "render/metaball_pool.h"
+#include "render/sim_clock.h"
+#include "render/surface_format.h"
+#include "render/timeline.h"
+
+class SoftCore;
+class FieldCache;
 
 class EGLCore {
 public:
@@ -27,14 +43,54 @@ public:
     void OnSurfaceCreated(void *window, int w, int h);
     void OnSurfaceChanged(void *window, int32_t w, int32_t h);
     void OnSurfaceDestroyed();
-    void RenderLoop();
-    void AddMetaballAt(float x, float y);
+    void RenderLoop(long long timestamp);
+    MetaballHandle AddMetaballAt(float x, float y);
+    bool RemoveMetaball(MetaballHandle handle);
+    bool MoveMetaball(MetaballHandle handle, float x, float y);
+    // False for a stale handle or a value outside [METABALL_MIN_RADIUS, METABALL_MAX_RADIUS],
+    // [0, METABALL_MAX_STRENGTH] or 0xRRGGBB respectively.
+    bool SetMetaballRadius(MetaballHandle handle, float radius);
+    bool SetMetaballStrength(MetaballHandle handle, float strength);
+    bool SetMetaballColor(MetaballHandle handle, uint32_t rgb);
     void ClearAllMetaballs();
+    void SetIncrementalField(bool enabled);
+    void SetGpuSimulation(bool enabled);
+    // False if the levels are out of order or outside [ISO_LEVEL_MIN, ISO_LEVEL_MAX].
+    bool SetIsoLevels(float halo, float inside);
+    void SetEdgeAntialiasing(bool enabled);
+    void SetBlockCulling(bool enabled);
+    // Read when the EGL surface is created, on the first VSync after OnSurfaceCreated; false if the
+    // profile is not a SurfaceProfile or samples is outside [0, SURFACE_MAX_SAMPLES].
+    bool SetSurfaceFormat(int32_t profile, bool srgb, int32_t samples);
+    // What the current surface got; RGBA8888 sRGB under the software renderer.
+    SurfaceFormat GetSurfaceFormat();
+    // False if strength is outside [0, METABALL_MAX_ATTRACTION] or theta outside [0, BH_MAX_THETA].
+    bool SetAttraction(float strength, float theta);
+    // Keyframe layout in render/timeline.h; false if the tracks are malformed.
+    bool LoadTimeline(const MetaballHandle *handles, int32_t trackCount, const float *keyframes, int32_t keyCount,
+                      bool loop);
+    void ClearTimeline();
+    // Takes ownership of tsfn; false if the request was rejected.
+    bool CaptureScene(int32_t width, int32_t height, napi_threadsafe_function tsfn);
+    float SampleField(float x, float y);
+    void HitTest(const float *points, size_t pointCount, uint8_t *levels);
+    static GLuint LoadShader(GLenum type, const char *shaderSrc);
+    static GLuint CreateProgram(const char *vertexShader, const char *fragShader);
+    // Programs and palette for the current context; surfaceFormat_ must already describe the surface.
+    bool InitGL();
 
 private:
     void Update();
-    GLuint LoadShader(GLenum type, const char *shaderSrc);
-    GLuint CreateProgram(const char *vertexShader, const char *fragShader);
+    void RequestNextFrame();
+    void DrawField(int numMetaballs, float scaleX, float scaleY);
+    void DrawFieldCulled(int numMetaballs, const IsoLevels &isoLevels);
+    void UseFieldProgram(int numMetaballs, float scaleX, float scaleY);
+    void PublishFrameEvents(long long timestamp, std::chrono::steady_clock::time_point frameStart, int32_t steps,
+                            int numMetaballs);
+    bool CreateWindowSurface();
+    void FallbackToSoftware(long long timestamp);
+    void UpdateFieldCacheState();
+    void UpdateGpuSimState();
 
 public:
     int32_t width_;
@@ -46,8 +102,36 @@ public:
     EGLContext mSharedEGLContext = EGL_NO_CONTEXT;
     EGLSurface mEGLSurface = nullptr;
     GLuint mProgramHandle;
+    GLuint flatProgram_ = 0;
     OH_NativeVSync *mVsync = nullptr;
-    float metaballRadiusSquared_;
+    // Non-null when rendering on the CPU because GLES 3 could not be brought up.
+    SoftCore *softCore_ = nullptr;
+    // Non-null while the incremental (cached field texture) mode is active.
+    FieldCache *fieldCache_ = nullptr;
+    // Set from the JS thread, applied on the render thread where the GL context lives.
+    std::atomic<bool> incrementalFieldRequested_{false};
+    std::atomic<bool> gpuSimulationRequested_{false};
+    GpuSim gpuSim_;
+    std::atomic<bool> edgeAntialiasRequested_{true};
+    IsoPalette isoPalette_;
+    std::atomic<bool> blockCullingRequested_{true};
+    BlockCuller blockCuller_;
+    SimClock simClock_;
+    std::atomic<float> attractionStrength_{0.0f};
+    std::atomic<float> attractionTheta_{BH_DEFAULT_THETA};
+    BarnesHut attraction_;
+    Timeline timeline_;
+    long long lastFrameTimestamp_ = 0;
+    int lastPostedBallCount_ = -1;
+    FieldIndex fieldIndex_;
+    FrameCapture frameCapture_;
+    // metaballArray as uploaded: x, y, weight (float bits) and RGBA8 tint per ball.
+    GLuint ballUniforms_[4 * MAX_METABALLS];
+    bool tinted_ = false;
+    // The request is written from the JS thread, the format only by the render thread.
+    std::mutex surfaceMutex_;
+    SurfaceRequest surfaceRequest_;
+    SurfaceFormat surfaceFormat_;
 
 private:
     std::string id_;
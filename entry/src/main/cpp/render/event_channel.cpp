@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hilog/log.h>
+#include <algorithm>
+#include "render/event_channel.h"
+#include "common/native_common.h"
+
+EventChannel g_renderEvents;
+
+uint32_t EventChannel::Subscribe(uint32_t mask, napi_threadsafe_function tsfn)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &sub : subscribers_) {
+        if (sub.id == 0 && !sub.delivery.inFlight.load() && !sub.lifecycle.inFlight.load()) {
+            sub.id = nextId_++;
+            if (nextId_ == 0) {
+                nextId_ = 1;
+            }
+            sub.mask = mask & RENDER_EVENT_ALL;
+            sub.tsfn = tsfn;
+            return sub.id;
+        }
+    }
+    LOGW("EventChannel: all %{public}d subscriber slots in use", EVENT_MAX_SUBSCRIBERS);
+    return 0;
+}
+
+bool EventChannel::Unsubscribe(uint32_t id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &sub : subscribers_) {
+        if (id != 0 && sub.id == id) {
+            napi_release_threadsafe_function(sub.tsfn, napi_tsfn_release);
+            Reset(sub);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Merge> void EventChannel::Post(RenderEventType type, const Merge &merge)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &sub : subscribers_) {
+        if (sub.id != 0 && (sub.mask & type)) {
+            merge(sub.pending);
+            sub.pending.types |= type;
+        }
+    }
+}
+
+void EventChannel::PostBallCount(int32_t count)
+{
+    Post(RENDER_EVENT_BALL_COUNT, [count](RenderEventBatch &batch) { batch.ballCount = count; });
+}
+
+void EventChannel::PostCapacityReached()
+{
+    Post(RENDER_EVENT_CAPACITY_REACHED, [](RenderEventBatch &batch) { batch.capacityRejections++; });
+}
+
+void EventChannel::PostFrame(double intervalMs, double cpuMs, int32_t simSteps)
+{
+    Post(RENDER_EVENT_FRAME_STATS, [=](RenderEventBatch &batch) {
+        batch.frames++;
+        batch.simSteps += (uint32_t)simSteps;
+        batch.frameIntervalSumMs += intervalMs;
+        batch.frameIntervalMaxMs = std::max(batch.frameIntervalMaxMs, intervalMs);
+        batch.cpuSumMs += cpuMs;
+    });
+}
+
+void EventChannel::PostSurface(SurfaceState state, int32_t w, int32_t h)
+{
+    Post(RENDER_EVENT_SURFACE, [=](RenderEventBatch &batch) {
+        batch.surfaceState = state;
+        batch.surfaceWidth = w;
+        batch.surfaceHeight = h;
+        batch.surfaceDestroyed = batch.surfaceDestroyed || state == SURFACE_DESTROYED;
+    });
+}
+
+void EventChannel::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &sub : subscribers_) {
+        if (sub.id == 0 || sub.pending.types == 0) {
+            continue;
+        }
+        if (!sub.delivery.inFlight.load()) {
+            if (Send(sub, sub.delivery, sub.pending)) {
+                sub.pending = RenderEventBatch();
+            }
+            continue;
+        }
+        // The surface callbacks run on the JS thread, so the queued batch cannot land while one of
+        // them flushes, and after a destroy no frame flushes again until the next surface exists.
+        // Surface changes therefore go out on their own instead of waiting behind it.
+        if ((sub.pending.types & RENDER_EVENT_SURFACE) == 0 || sub.lifecycle.inFlight.load()) {
+            continue;
+        }
+        RenderEventBatch surface;
+        surface.types = RENDER_EVENT_SURFACE;
+        surface.surfaceState = sub.pending.surfaceState;
+        surface.surfaceWidth = sub.pending.surfaceWidth;
+        surface.surfaceHeight = sub.pending.surfaceHeight;
+        surface.surfaceDestroyed = sub.pending.surfaceDestroyed;
+        if (Send(sub, sub.lifecycle, surface)) {
+            sub.pending.types &= ~(uint32_t)RENDER_EVENT_SURFACE;
+            sub.pending.surfaceDestroyed = false;
+        }
+    }
+}
+
+bool EventChannel::Send(Subscriber &sub, Delivery &delivery, const RenderEventBatch &batch)
+{
+    delivery.batch = batch;
+    delivery.inFlight.store(true);
+    if (napi_call_threadsafe_function(sub.tsfn, &delivery, napi_tsfn_nonblocking) != napi_ok) {
+        // Keep the batch and retry next frame.
+        delivery.inFlight.store(false);
+        return false;
+    }
+    return true;
+}
+
+void EventChannel::Reset(Subscriber &sub)
+{
+    sub.id = 0;
+    sub.mask = 0;
+    sub.tsfn = nullptr;
+    // A queued delivery still lands; it clears its own flag.
+    sub.pending = RenderEventBatch();
+}
+
+static void SetInt(napi_env env, napi_value object, const char *name, int64_t value)
+{
+    napi_value v;
+    if (napi_create_double(env, (double)value, &v) == napi_ok) {
+        napi_set_named_property(env, object, name, v);
+    }
+}
+
+static void SetBool(napi_env env, napi_value object, const char *name, bool value)
+{
+    napi_value v;
+    if (napi_get_boolean(env, value, &v) == napi_ok) {
+        napi_set_named_property(env, object, name, v);
+    }
+}
+
+static void SetDouble(napi_env env, napi_value object, const char *name, double value)
+{
+    napi_value v;
+    if (napi_create_double(env, value, &v) == napi_ok) {
+        napi_set_named_property(env, object, name, v);
+    }
+}
+
+void EventChannel::CallJs(napi_env env, napi_value jsCallback, void *context, void *data)
+{
+    Delivery *delivery = static_cast<Delivery *>(data);
+    const RenderEventBatch &batch = delivery->batch;
+    napi_value object;
+    if (env != nullptr && jsCallback != nullptr && napi_create_object(env, &object) == napi_ok) {
+        SetInt(env, object, "types", batch.types);
+        if (batch.types & RENDER_EVENT_BALL_COUNT) {
+            SetInt(env, object, "ballCount", batch.ballCount);
+        }
+        if (batch.types & RENDER_EVENT_CAPACITY_REACHED) {
+            SetInt(env, object, "capacityRejections", batch.capacityRejections);
+        }
+        if (batch.types & RENDER_EVENT_FRAME_STATS) {
+            SetInt(env, object, "frames", batch.frames);
+            SetInt(env, object, "simSteps", batch.simSteps);
+            SetDouble(env, object, "avgFrameIntervalMs", batch.frameIntervalSumMs / batch.frames);
+            SetDouble(env, object, "maxFrameIntervalMs", batch.frameIntervalMaxMs);
+            SetDouble(env, object, "avgCpuMs", batch.cpuSumMs / batch.frames);
+        }
+        if (batch.types & RENDER_EVENT_SURFACE) {
+            SetInt(env, object, "surfaceState", batch.surfaceState);
+            SetInt(env, object, "surfaceWidth", batch.surfaceWidth);
+            SetInt(env, object, "surfaceHeight", batch.surfaceHeight);
+            SetBool(env, object, "surfaceDestroyed", batch.surfaceDestroyed);
+        }
+        napi_value undefined;
+        napi_get_undefined(env, &undefined);
+        napi_call_function(env, undefined, jsCallback, 1, &object, nullptr);
+    }
+    delivery->inFlight.store(false);
+}
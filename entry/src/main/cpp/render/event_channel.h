@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_CHANNEL_H
+#define EVENT_CHANNEL_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <napi/native_api.h>
+
+#define EVENT_MAX_SUBSCRIBERS 8
+
+// Bit flags; subscribers pass a mask of the types they want.
+enum RenderEventType : uint32_t {
+    RENDER_EVENT_BALL_COUNT = 1u << 0,
+    RENDER_EVENT_CAPACITY_REACHED = 1u << 1,
+    RENDER_EVENT_FRAME_STATS = 1u << 2,
+    RENDER_EVENT_SURFACE = 1u << 3,
+    RENDER_EVENT_ALL = 0xFu
+};
+
+enum SurfaceState : int32_t {
+    SURFACE_CREATED = 1,
+    SURFACE_CHANGED = 2,
+    SURFACE_DESTROYED = 3
+};
+
+// Everything a subscriber missed since its last delivery, merged per type.
+struct RenderEventBatch {
+    uint32_t types = 0;
+    int32_t ballCount = 0;
+    uint32_t capacityRejections = 0;
+    uint32_t frames = 0;
+    uint32_t simSteps = 0;
+    double frameIntervalSumMs = 0.0;
+    double frameIntervalMaxMs = 0.0;
+    double cpuSumMs = 0.0;
+    int32_t surfaceState = 0;
+    int32_t surfaceWidth = 0;
+    int32_t surfaceHeight = 0;
+    // Sticky, so a CREATED merged in after a DESTROYED does not hide that the old surface is gone.
+    bool surfaceDestroyed = false;
+};
+
+/**
+ * Native-to-ArkTS notifications.
+ * Producers on any thread post into a per-subscriber pending batch, which
+ * only ever takes a short lock. Flush, called once per frame by the render
+ * loop, hands each subscriber its batch through its threadsafe function.
+ * While a batch is still waiting for the JS thread, newer events keep merging
+ * into the next one, so a slow or busy JS thread sees fewer, larger batches
+ * and the render thread never waits on it.
+ */
+class EventChannel {
+public:
+    // JS thread. Takes ownership of tsfn; returns 0 if every subscriber slot is taken.
+    uint32_t Subscribe(uint32_t mask, napi_threadsafe_function tsfn);
+    // JS thread. Batches already queued are still delivered.
+    bool Unsubscribe(uint32_t id);
+
+    void PostBallCount(int32_t count);
+    void PostCapacityReached();
+    void PostFrame(double intervalMs, double cpuMs, int32_t simSteps);
+    void PostSurface(SurfaceState state, int32_t w, int32_t h);
+    // Any thread; never blocks on JS.
+    void Flush();
+
+    // Matches napi_threadsafe_function_call_js; turns a batch into a JS object and calls back.
+    static void CallJs(napi_env env, napi_value jsCallback, void *context, void *data);
+
+private:
+    // What the threadsafe function carries to CallJs.
+    struct Delivery {
+        // Set while batch is queued for JS. Cleared from CallJs without the lock, so
+        // delivery never contends with a Flush in progress.
+        std::atomic<bool> inFlight{false};
+        RenderEventBatch batch;
+    };
+
+    struct Subscriber {
+        uint32_t id = 0;
+        uint32_t mask = 0;
+        napi_threadsafe_function tsfn = nullptr;
+        // At most one batch is queued per subscriber, so one delivery is reused for all of them.
+        // A slot whose delivery is still queued is not handed to a new subscriber.
+        Delivery delivery;
+        // Carries surface changes alone while delivery is still queued; see Flush.
+        Delivery lifecycle;
+        RenderEventBatch pending;
+    };
+
+    // A template rather than std::function, so the per-frame posts never touch the heap.
+    template <typename Merge> void Post(RenderEventType type, const Merge &merge);
+    static bool Send(Subscriber &sub, Delivery &delivery, const RenderEventBatch &batch);
+    static void Reset(Subscriber &sub);
+
+    std::mutex mutex_;
+    Subscriber subscribers_[EVENT_MAX_SUBSCRIBERS];
+    uint32_t nextId_ = 1;
+};
+
+extern EventChannel g_renderEvents;
+
+#endif // EVENT_CHANNEL_H
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hilog/log.h>
+#include <cmath>
+#include <cstring>
+#include "render/egl_core_shader.h"
+#include "render/field_cache.h"
+#include "render/iso_palette.h"
+#include "common/native_common.h"
+
+// Any single contribution this large already puts the pixel above every isolevel;
+// clamping keeps a ball's add and later subtract from cancelling away the rest of the sum.
+#define FIELD_CLAMP 4.0f
+#define FIELD_REBUILD_INTERVAL 120
+// Budgeted cost of one moved ball's full-screen accumulate pass, in iterations of the direct shader's
+// per-ball loop. Mesa llvmpipe measures ~0.7 (field_cache/frame_466/moved_* against field_cache/direct_466),
+// but each pass also reads and writes the whole R32F target, bandwidth a tiler GPU pays and the
+// software rasterizer hides; hence the headroom.
+#define FIELD_UPDATE_COST 4
+#define INSTANCE_FLOATS 6
+
+char g_fieldAccumVertexShader[] = "#version 300 es\n"
+                                  "layout(location = 0) in vec2 a_corner;\n"
+                                  "layout(location = 1) in vec4 a_centers;\n"
+                                  "layout(location = 2) in vec2 a_weights;\n"
+                                  "flat out vec4 v_centers;\n"
+                                  "flat out vec2 v_weights;\n"
+                                  "void main()\n"
+                                  "{\n"
+                                  "   v_centers = a_centers;\n"
+                                  "   v_weights = a_weights;\n"
+                                  "   gl_Position = vec4(a_corner * 2.0 - 1.0, 0.0, 1.0);\n"
+                                  "}\n";
+
+char g_fieldAccumFragmentShader[] = "#version 300 es\n"
+                                    "precision highp float;\n"
+                                    "flat in vec4 v_centers;\n"
+                                    "flat in vec2 v_weights;\n"
+                                    "out vec4 fragColor;\n"
+                                    "uniform float screenHeight;\n"
+                                    "uniform float fieldClamp;\n"
+                                    "float contribution(vec2 center, vec2 pixelCoord, float weight)\n"
+                                    "{\n"
+                                    "   vec2 diff = center - pixelCoord;\n"
+                                    "   float distSquared = dot(diff, diff);\n"
+                                    "   if(distSquared < 0.001) distSquared = 0.001;\n"
+                                    "   return sign(weight) * min(abs(weight) / distSquared, fieldClamp);\n"
+                                    "}\n"
+                                    "void main()\n"
+                                    "{\n"
+                                    "   vec2 pixelCoord = gl_FragCoord.xy;\n"
+                                    "   pixelCoord.y = screenHeight - pixelCoord.y;\n"
+                                    "   float delta = contribution(v_centers.xy, pixelCoord, v_weights.x)\n"
+                                    "               + contribution(v_centers.zw, pixelCoord, v_weights.y);\n"
+                                    "   fragColor = vec4(delta, 0.0, 0.0, 0.0);\n"
+                                    "}\n";
+
+char g_fieldCompositeVertexShader[] = "#version 300 es\n"
+                                      "layout(location = 0) in vec2 a_corner;\n"
+                                      "void main()\n"
+                                      "{\n"
+                                      "   gl_Position = vec4(a_corner * 2.0 - 1.0, 0.0, 1.0);\n"
+                                      "}\n";
+
+char g_fieldCompositeFragmentShader[] = "#version 300 es\n"
+                                        "precision highp float;\n"
+                                        "out vec4 fragColor;\n"
+                                        // Samplers default to lowp, which may hand back the field at half precision.
+                                        "uniform highp sampler2D fieldTexture;\n"
+                                        ISO_SHADE_GLSL
+                                        "void main()\n"
+                                        "{\n"
+                                        "   float sum = texelFetch(fieldTexture, ivec2(gl_FragCoord.xy), 0).r;\n"
+                                        "   fragColor = vec4(encodeOutput(shadeField(sum)), 1.0);\n"
+                                        "}\n";
+
+static bool HasExtension(const char *name)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++) {
+        const char *ext = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+        if (ext && strcmp(ext, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FieldCache::Init(int32_t w, int32_t h)
+{
+    // Additive blending into the field needs a float target that is both renderable and blendable.
+    // Half floats are not enough: their round-off piles up over FIELD_REBUILD_INTERVAL frames of updates.
+    if (!HasExtension("GL_EXT_color_buffer_float") || !HasExtension("GL_EXT_float_blend")) {
+        LOGW("FieldCache: no blendable R32F color buffer, incremental field unavailable");
+        return false;
+    }
+
+    accumProgram_ = EGLCore::CreateProgram(g_fieldAccumVertexShader, g_fieldAccumFragmentShader);
+    compositeProgram_ = EGLCore::CreateProgram(g_fieldCompositeVertexShader, g_fieldCompositeFragmentShader);
+    if (!accumProgram_ || !compositeProgram_) {
+        LOGE("FieldCache: could not create programs");
+        Release();
+        return false;
+    }
+
+    const GLfloat corners[] = {0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f};
+    glGenVertexArrays(1, &vao_);
+    glGenBuffers(1, &cornerVbo_);
+    glGenBuffers(1, &instanceVbo_);
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, cornerVbo_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(instances_), nullptr, GL_STREAM_DRAW);
+    const GLsizei stride = INSTANCE_FLOATS * sizeof(float);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void *>(0));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void *>(4 * sizeof(float)));
+    for (GLuint attr = 1; attr <= 2; attr++) {
+        glEnableVertexAttribArray(attr);
+        glVertexAttribDivisor(attr, 1);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glUseProgram(accumProgram_);
+    glUniform1f(glGetUniformLocation(accumProgram_, "fieldClamp"), FIELD_CLAMP);
+    glUseProgram(compositeProgram_);
+    glUniform1i(glGetUniformLocation(compositeProgram_, "fieldTexture"), 0);
+
+    Resize(w, h);
+    LOGI("FieldCache initialized");
+    return true;
+}
+
+void FieldCache::Release()
+{
+    if (fbo_) {
+        glDeleteFramebuffers(1, &fbo_);
+        fbo_ = 0;
+    }
+    if (fieldTexture_) {
+        glDeleteTextures(1, &fieldTexture_);
+        fieldTexture_ = 0;
+    }
+    if (vao_) {
+        glDeleteVertexArrays(1, &vao_);
+        vao_ = 0;
+    }
+    if (cornerVbo_) {
+        glDeleteBuffers(1, &cornerVbo_);
+        cornerVbo_ = 0;
+    }
+    if (instanceVbo_) {
+        glDeleteBuffers(1, &instanceVbo_);
+        instanceVbo_ = 0;
+    }
+    if (accumProgram_) {
+        glDeleteProgram(accumProgram_);
+        accumProgram_ = 0;
+    }
+    if (compositeProgram_) {
+        glDeleteProgram(compositeProgram_);
+        compositeProgram_ = 0;
+    }
+    valid_ = false;
+}
+
+void FieldCache::Resize(int32_t w, int32_t h)
+{
+    if (w == width_ && h == height_ && fieldTexture_) {
+        return;
+    }
+    width_ = w;
+    height_ = h;
+    CreateFieldTarget();
+
+    glUseProgram(accumProgram_);
+    glUniform1f(glGetUniformLocation(accumProgram_, "screenHeight"), (float)h);
+}
+
+void FieldCache::CreateFieldTarget()
+{
+    if (!fieldTexture_) {
+        glGenTextures(1, &fieldTexture_);
+        glGenFramebuffers(1, &fbo_);
+    }
+    glBindTexture(GL_TEXTURE_2D, fieldTexture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, width_, height_, 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, fieldTexture_, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        LOGE("FieldCache: field framebuffer incomplete");
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    valid_ = false;
+}
+
+int32_t FieldCache::AppendInstance(int32_t index, float oldX, float oldY, float newX, float newY, float oldWeight,
+                                   float newWeight)
+{
+    float *inst = &instances_[index * INSTANCE_FLOATS];
+    inst[0] = oldX;
+    inst[1] = oldY;
+    inst[2] = newX;
+    inst[3] = newY;
+    inst[4] = oldWeight;
+    inst[5] = newWeight;
+    return index + 1;
+}
+
+bool FieldCache::Update(const float *positions, const float *weights, int32_t count, uint32_t revision)
+{
+    // After a structural change every ball counts as moved.
+    bool sameBalls = revision == revision_ && count == count_;
+    int32_t moved = 0;
+    for (int32_t i = 0; i < count; i++) {
+        if (!sameBalls || previous_[2 * i] != positions[2 * i] || previous_[2 * i + 1] != positions[2 * i + 1] ||
+            previousWeights_[i] != weights[i]) {
+            moved = AppendInstance(moved, previous_[2 * i], previous_[2 * i + 1], positions[2 * i],
+                                   positions[2 * i + 1], -previousWeights_[i], weights[i]);
+        }
+    }
+    memcpy(previous_, positions, 2 * count * sizeof(float));
+    memcpy(previousWeights_, weights, count * sizeof(float));
+    count_ = count;
+    revision_ = revision;
+
+    // Every moved ball is a full-screen pass, so a busy frame is cheaper to evaluate directly.
+    // The cache then goes stale and is rebuilt once the scene quiets down.
+    if (moved * FIELD_UPDATE_COST > count) {
+        valid_ = false;
+        lastUpdatedBalls_ = 0;
+        return false;
+    }
+    bool rebuild = !valid_ || ++framesSinceRebuild_ >= FIELD_REBUILD_INTERVAL;
+    int32_t instanceCount = moved;
+    if (rebuild) {
+        instanceCount = 0;
+        for (int32_t i = 0; i < count; i++) {
+            instanceCount = AppendInstance(instanceCount, positions[2 * i], positions[2 * i + 1], positions[2 * i],
+                                           positions[2 * i + 1], 0.0f, weights[i]);
+        }
+    }
+    lastUpdatedBalls_ = instanceCount;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glViewport(0, 0, width_, height_);
+    if (rebuild) {
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        framesSinceRebuild_ = 0;
+        valid_ = true;
+    }
+    if (instanceCount > 0) {
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVbo_);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instanceCount * INSTANCE_FLOATS * sizeof(float), instances_);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glEnable(GL_BLEND);
+        glBlendEquation(GL_FUNC_ADD);
+        glBlendFunc(GL_ONE, GL_ONE);
+        glUseProgram(accumProgram_);
+        glBindVertexArray(vao_);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, instanceCount);
+        glBindVertexArray(0);
+        glDisable(GL_BLEND);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return true;
+}
+
+void FieldCache::Draw(const IsoPalette &palette)
+{
+    glUseProgram(compositeProgram_);
+    palette.Apply(compositeProgram_);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, fieldTexture_);
+    glBindVertexArray(vao_);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIELD_CACHE_H
+#define FIELD_CACHE_H
+
+#include <cstdint>
+#include <GLES3/gl3.h>
+#include "render/metaball_pool.h"
+
+class IsoPalette;
+
+/**
+ * Incremental field mode.
+ * The summed field lives in a persistent R32F texture. A frame where only a
+ * few balls moved redraws just those, as one instanced full-screen quad per
+ * ball that subtracts the old contribution and adds the new one, so the
+ * cached sum stays exact rather than truncated. A composite pass then shades
+ * it with the same ISO_SHADE_GLSL as g_fragmentShader. When more than
+ * 1 / FIELD_UPDATE_COST of the balls moved, Update declines and the caller
+ * evaluates the field directly. The whole field is rebuilt after structural
+ * changes and every FIELD_REBUILD_INTERVAL frames to bound blending round-off.
+ */
+class FieldCache {
+public:
+    // Needs a blendable float color buffer; returns false if the driver has none.
+    bool Init(int32_t w, int32_t h);
+    void Release();
+    void Resize(int32_t w, int32_t h);
+    // Brings the cached field up to date with the frame's positions and weights (strength * radius^2).
+    // False if too many balls moved for that to beat a direct evaluation; the cache is then stale.
+    bool Update(const float *positions, const float *weights, int32_t count, uint32_t revision);
+    // Shades the cached field into the currently bound framebuffer.
+    void Draw(const IsoPalette &palette);
+    int32_t LastUpdatedBalls() const { return lastUpdatedBalls_; }
+
+private:
+    void CreateFieldTarget();
+    int32_t AppendInstance(int32_t index, float oldX, float oldY, float newX, float newY, float oldWeight,
+                           float newWeight);
+
+    GLuint accumProgram_ = 0;
+    GLuint compositeProgram_ = 0;
+    GLuint vao_ = 0;
+    GLuint cornerVbo_ = 0;
+    GLuint instanceVbo_ = 0;
+    GLuint fieldTexture_ = 0;
+    GLuint fbo_ = 0;
+    int32_t width_ = 0;
+    int32_t height_ = 0;
+
+    bool valid_ = false;
+    uint32_t revision_ = 0;
+    int32_t count_ = 0;
+    int32_t framesSinceRebuild_ = 0;
+    int32_t lastUpdatedBalls_ = 0;
+    float previous_[2 * MAX_METABALLS];
+    float previousWeights_[MAX_METABALLS];
+    // Old and new centers (4) + old and new weights (2) per instance.
+    float instances_[6 * MAX_METABALLS];
+};
+
+#endif // FIELD_CACHE_H
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include "render/field_query.h"
+
+// Same clamp as the shader's "if(distSquared < 0.001)".
+#define MIN_DIST_SQUARED 0.001f
+// Points summed side by side in HitTest; one vector's worth or two on NEON and SSE.
+#define QUERY_BATCH 8
+
+void FieldIndex::Publish(const float *positions, const float *weights, int32_t count, const IsoLevels &levels)
+{
+    for (int32_t i = 0; i < count; i++) {
+        back_->x[i] = positions[2 * i];
+        back_->y[i] = positions[2 * i + 1];
+        back_->weight[i] = weights[i];
+    }
+    back_->count = count;
+    back_->levels = levels;
+    // Only swap if no query holds the front copy; otherwise try again next frame.
+    if (frontMutex_.try_lock()) {
+        std::swap(front_, back_);
+        frontMutex_.unlock();
+    }
+}
+
+float FieldIndex::Sample(float x, float y)
+{
+    float point[2] = {x, y};
+    float sum;
+    std::lock_guard<std::mutex> lock(frontMutex_);
+    SumBatch(*front_, point, 1, &sum);
+    return sum;
+}
+
+void FieldIndex::HitTest(const float *points, size_t pointCount, uint8_t *levels)
+{
+    std::lock_guard<std::mutex> lock(frontMutex_);
+    float halo = front_->levels.halo;
+    float inside = front_->levels.inside;
+    for (size_t first = 0; first < pointCount; first += QUERY_BATCH) {
+        int32_t batch = (int32_t)std::min(pointCount - first, (size_t)QUERY_BATCH);
+        float sums[QUERY_BATCH];
+        SumBatch(*front_, points + 2 * first, batch, sums);
+        for (int32_t j = 0; j < batch; j++) {
+            levels[first + j] = sums[j] >= inside ? FIELD_LEVEL_INSIDE
+                                                  : (sums[j] >= halo ? FIELD_LEVEL_HALO : FIELD_LEVEL_OUTSIDE);
+        }
+    }
+}
+
+// Balls outer, points inner: each point's sum still adds the balls in shader order,
+// while the inner loop has no dependency between iterations and vectorizes.
+void FieldIndex::SumBatch(const Balls &balls, const float *points, int32_t pointCount, float *sums)
+{
+    float px[QUERY_BATCH];
+    float py[QUERY_BATCH];
+    float sum[QUERY_BATCH];
+    for (int32_t j = 0; j < QUERY_BATCH; j++) {
+        // Short batches repeat their last point so the inner loop keeps a fixed trip count.
+        int32_t src = std::min(j, pointCount - 1);
+        px[j] = points[2 * src];
+        py[j] = points[2 * src + 1];
+        sum[j] = 0.0f;
+    }
+    for (int32_t i = 0; i < balls.count; i++) {
+        float bx = balls.x[i];
+        float by = balls.y[i];
+        float bw = balls.weight[i];
+        for (int32_t j = 0; j < QUERY_BATCH; j++) {
+            float dx = bx - px[j];
+            float dy = by - py[j];
+            float d2 = dx * dx + dy * dy;
+            sum[j] += bw / (d2 < MIN_DIST_SQUARED ? MIN_DIST_SQUARED : d2);
+        }
+    }
+    for (int32_t j = 0; j < pointCount; j++) {
+        sums[j] = sum[j];
+    }
+}
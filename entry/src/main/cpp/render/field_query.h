@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIELD_QUERY_H
+#define FIELD_QUERY_H
+
+#include <cstdint>
+#include <mutex>
+#include "render/iso_levels.h"
+#include "render/metaball_pool.h"
+
+enum FieldLevel : uint8_t {
+    FIELD_LEVEL_OUTSIDE = 0,
+    FIELD_LEVEL_HALO = 1,  // sum >= IsoLevels::halo, the darker outer band
+    FIELD_LEVEL_INSIDE = 2 // sum >= IsoLevels::inside, the blob core
+};
+
+/**
+ * CPU-side view of the metaball field for UI queries.
+ * The render thread publishes the frame's ball centers and weights as plain
+ * arrays; queries sum every ball, in the same order and with the same falloff
+ * as g_fragmentShader. At MAX_METABALLS a straight loop beats any spatial
+ * index (bench: field_index/hit_test against field_index/brute_force), and
+ * HitTest runs it for a batch of points at once so the compiler can vectorize
+ * across points without reordering any point's sum.
+ * The arrays are double-buffered: the render thread fills the back copy and
+ * swaps with try_lock, so a query in flight can delay a publish but never block it.
+ */
+class FieldIndex {
+public:
+    // Render thread, once per frame after positions are packed.
+    // weights holds each ball's strength * radius^2, as in g_metaballWeights.
+    void Publish(const float *positions, const float *weights, int32_t count, const IsoLevels &levels);
+    // Any thread. Same value g_fragmentShader computes at pixel (x, y), to within 1e-3.
+    float Sample(float x, float y);
+    // Any thread. points is [x0, y0, x1, y1, ...]; writes one FieldLevel per point.
+    void HitTest(const float *points, size_t pointCount, uint8_t *levels);
+
+private:
+    struct Balls {
+        IsoLevels levels;
+        int32_t count = 0;
+        float x[MAX_METABALLS];
+        float y[MAX_METABALLS];
+        float weight[MAX_METABALLS];
+    };
+
+    static void SumBatch(const Balls &balls, const float *points, int32_t pointCount, float *sums);
+
+    Balls balls_[2];
+    Balls *front_ = &balls_[0];
+    Balls *back_ = &balls_[1];
+    std::mutex frontMutex_;
+};
+
+#endif // FIELD_QUERY_H
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hilog/log.h>
+#include <cstring>
+#include "render/frame_capture.h"
+#include "common/native_common.h"
+
+#define CAPTURE_MAX_SIZE 2048
+
+// pixels == nullptr rejects the capture.
+struct CapturePayload {
+    int32_t width;
+    int32_t height;
+    uint8_t *pixels;
+};
+
+bool FrameCapture::Request(int32_t width, int32_t height, napi_threadsafe_function tsfn)
+{
+    if (width <= 0 || height <= 0 || width > CAPTURE_MAX_SIZE || height > CAPTURE_MAX_SIZE) {
+        LOGE("FrameCapture: invalid size %{public}dx%{public}d", width, height);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &slot : slots_) {
+        if (slot.state == SLOT_FREE) {
+            slot.width = width;
+            slot.height = height;
+            slot.tsfn = tsfn;
+            slot.state = SLOT_QUEUED;
+            return true;
+        }
+    }
+    LOGW("FrameCapture: all capture slots busy");
+    return false;
+}
+
+void FrameCapture::Process(const std::function<void(int32_t, int32_t)> &drawScene)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &slot : slots_) {
+        if (slot.state == SLOT_READING) {
+            // Zero timeout: only look at the fence, never wait on it.
+            GLenum result = glClientWaitSync(slot.fence, 0, 0);
+            if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+                Deliver(slot);
+            }
+        } else if (slot.state == SLOT_QUEUED) {
+            Start(slot, drawScene);
+        }
+    }
+}
+
+void FrameCapture::Start(Slot &slot, const std::function<void(int32_t, int32_t)> &drawScene)
+{
+    if (!slot.fbo) {
+        glGenFramebuffers(1, &slot.fbo);
+        glGenRenderbuffers(1, &slot.rbo);
+        glGenBuffers(1, &slot.pbo);
+    }
+    // Same sRGB encoding as the window surface, so thumbnails match the screen.
+    glBindRenderbuffer(GL_RENDERBUFFER, slot.rbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_SRGB8_ALPHA8, slot.width, slot.height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, slot.fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, slot.rbo);
+
+    GLsizeiptr bytes = (GLsizeiptr)slot.width * slot.height * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+
+    glViewport(0, 0, slot.width, slot.height);
+    drawScene(slot.width, slot.height);
+
+    // With a pack buffer bound this only queues the copy; the data pointer is an offset.
+    glReadPixels(0, 0, slot.width, slot.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.state = SLOT_READING;
+}
+
+void FrameCapture::Deliver(Slot &slot)
+{
+    size_t rowBytes = (size_t)slot.width * 4;
+    size_t bytes = rowBytes * slot.height;
+    CapturePayload *payload = new CapturePayload{slot.width, slot.height, nullptr};
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    const uint8_t *mapped =
+        static_cast<const uint8_t *>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT));
+    if (mapped) {
+        // GL rows start at the bottom; JS gets the usual top-down layout.
+        payload->pixels = new uint8_t[bytes];
+        for (int32_t y = 0; y < slot.height; y++) {
+            memcpy(payload->pixels + (size_t)y * rowBytes, mapped + (size_t)(slot.height - 1 - y) * rowBytes,
+                   rowBytes);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        LOGE("FrameCapture: glMapBufferRange failed");
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    Complete(slot, payload);
+}
+
+void FrameCapture::Complete(Slot &slot, void *payload)
+{
+    if (napi_call_threadsafe_function(slot.tsfn, payload, napi_tsfn_nonblocking) != napi_ok) {
+        LOGE("FrameCapture: could not queue JS callback");
+        CapturePayload *dropped = static_cast<CapturePayload *>(payload);
+        delete[] dropped->pixels;
+        delete dropped;
+    }
+    napi_release_threadsafe_function(slot.tsfn, napi_tsfn_release);
+    slot.tsfn = nullptr;
+    slot.state = SLOT_FREE;
+}
+
+void FrameCapture::Abandon()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &slot : slots_) {
+        if (slot.tsfn) {
+            LOGW("FrameCapture: surface destroyed, rejecting a pending %{public}dx%{public}d capture", slot.width,
+                 slot.height);
+            Complete(slot, new CapturePayload{slot.width, slot.height, nullptr});
+        }
+        // The objects die with the context; a new context starts from fresh names.
+        slot.fbo = slot.rbo = slot.pbo = 0;
+        slot.fence = nullptr;
+        slot.state = SLOT_FREE;
+    }
+}
+
+void FrameCapture::CallJs(napi_env env, napi_value jsCallback, void *context, void *data)
+{
+    CapturePayload *payload = static_cast<CapturePayload *>(data);
+    if (env != nullptr && jsCallback != nullptr) {
+        size_t bytes = (size_t)payload->width * payload->height * 4;
+        void *target = nullptr;
+        napi_value args[3];
+        napi_status status = payload->pixels ? napi_create_arraybuffer(env, bytes, &target, &args[0])
+                                             : napi_get_null(env, &args[0]);
+        if (status == napi_ok) {
+            if (payload->pixels) {
+                memcpy(target, payload->pixels, bytes);
+            }
+            napi_create_int32(env, payload->width, &args[1]);
+            napi_create_int32(env, payload->height, &args[2]);
+            napi_value undefined;
+            napi_get_undefined(env, &undefined);
+            napi_call_function(env, undefined, jsCallback, 3, args, nullptr);
+        }
+    }
+    delete[] payload->pixels;
+    delete payload;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <GLES3/gl3.h>
+#include <napi/native_api.h>
+
+#define CAPTURE_SLOTS 3
+
+/**
+ * Asynchronous offscreen captures for thumbnails and screenshots.
+ * After a frame is swapped, a request renders the scene into its own sRGB FBO
+ * at the requested size, starts a glReadPixels into a pixel buffer object and
+ * drops a fence. Later frames poll the fence without waiting; once it has
+ * signaled, the PBO is mapped, rows are flipped to top-down RGBA and the pixels
+ * are handed to JS through the request's threadsafe function. The on-screen
+ * frame never waits on a readback. Every accepted request gets exactly one
+ * callback: the pixels, or null if the capture could not finish.
+ */
+class FrameCapture {
+public:
+    // JS thread. Takes ownership of tsfn; false if too many captures are pending.
+    bool Request(int32_t width, int32_t height, napi_threadsafe_function tsfn);
+    // Render thread, once per frame after eglSwapBuffers, with the GL context current.
+    // drawScene renders the scene into the bound framebuffer at the given size.
+    void Process(const std::function<void(int32_t, int32_t)> &drawScene);
+    // Any thread, no context needed: the context is going away with the objects in it.
+    // Only forgets the GL names and rejects every pending capture.
+    void Abandon();
+
+    // Matches napi_threadsafe_function_call_js; builds the ArrayBuffer and calls back.
+    static void CallJs(napi_env env, napi_value jsCallback, void *context, void *data);
+
+private:
+    enum SlotState { SLOT_FREE, SLOT_QUEUED, SLOT_READING };
+    struct Slot {
+        SlotState state = SLOT_FREE;
+        int32_t width = 0;
+        int32_t height = 0;
+        napi_threadsafe_function tsfn = nullptr;
+        GLuint fbo = 0;
+        GLuint rbo = 0;
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+    };
+
+    void Start(Slot &slot, const std::function<void(int32_t, int32_t)> &drawScene);
+    void Deliver(Slot &slot);
+    // Hands the payload (pixels or a rejection) to JS and frees the slot.
+    static void Complete(Slot &slot, void *payload);
+
+    std::mutex mutex_;
+    Slot slots_[CAPTURE_SLOTS];
+};
+
+#endif // FRAME_CAPTURE_H
@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hilog/log.h>
+#include <cstdlib>
+#include <cstring>
+#include "render/egl_core_shader.h"
+#include "render/gpu_sim.h"
+#include "render/iso_palette.h"
+#include "common/native_common.h"
+
+#define GPU_SIM_RECORD_WORDS 8
+#define GPU_SIM_RECORD_BYTES (GPU_SIM_RECORD_WORDS * sizeof(uint32_t))
+// Words 6 and 7: weight and tint.
+#define GPU_SIM_STYLE_OFFSET (6 * sizeof(uint32_t))
+#define GPU_SIM_BUFFER_BYTES (MAX_METABALLS * GPU_SIM_RECORD_BYTES)
+#define GPU_SIM_BALL_BINDING 0
+
+// Runs all of a frame's fixed steps per ball; mirrors UpdateMetaballs step for step.
+// The second half is integer so the tint's bits survive the round trip untouched.
+char g_gpuStepVertexShader[] = "#version 300 es\n"
+                               "layout(location = 0) in vec4 a_position;\n"
+                               "layout(location = 1) in uvec4 a_motion;\n"
+                               "uniform int steps;\n"
+                               "uniform float speed;\n"
+                               "uniform vec2 bounds;\n"
+                               "out vec4 v_position;\n"
+                               "flat out uvec4 v_motion;\n"
+                               "void main()\n"
+                               "{\n"
+                               "   vec2 pos = a_position.xy;\n"
+                               "   vec2 prev = a_position.zw;\n"
+                               "   vec2 dir = uintBitsToFloat(a_motion.xy);\n"
+                               "   for(int i = 0; i < steps; i++) {\n"
+                               "       prev = pos;\n"
+                               "       pos += dir * speed;\n"
+                               "       if(pos.x >= bounds.x || pos.x <= 0.0) dir.x = -dir.x;\n"
+                               "       if(pos.y >= bounds.y || pos.y <= 0.0) dir.y = -dir.y;\n"
+                               "   }\n"
+                               "   v_position = vec4(pos, prev);\n"
+                               "   v_motion = uvec4(floatBitsToUint(dir), a_motion.zw);\n"
+                               "}\n";
+
+// ES 3.0 will not link a program without one, even with rasterization off.
+char g_gpuStepFragmentShader[] = "#version 300 es\n"
+                                 "precision mediump float;\n"
+                                 "out vec4 fragColor;\n"
+                                 "void main()\n"
+                                 "{\n"
+                                 "   fragColor = vec4(0.0);\n"
+                                 "}\n";
+
+char g_gpuFieldVertexShader[] = "#version 300 es\n"
+                                "layout(location = 0) in vec4 a_position;\n"
+                                "void main()\n"
+                                "{\n"
+                                "   gl_Position = a_position;\n"
+                                "}\n";
+
+// g_fragmentShader with the centers read from the state buffer and interpolated here.
+char g_gpuFieldFragmentShader[] = "#version 300 es\n"
+                                  "precision highp float;\n"
+                                  "out vec4 fragColor;\n"
+                                  "layout(std140) uniform BallState {\n"
+                                  "   highp uvec4 ballState[200];\n"
+                                  "};\n"
+                                  "uniform int numMetaballs;\n"
+                                  "uniform float alpha;\n"
+                                  "uniform float screenHeight;\n"
+                                  "uniform bool tinted;\n"
+                                  "uniform vec2 pixelScale;\n"
+                                  ISO_SHADE_GLSL
+                                  ISO_TINT_GLSL
+                                  "void main()\n"
+                                  "{\n"
+                                  "   vec2 pixelCoord = gl_FragCoord.xy * pixelScale;\n"
+                                  "   pixelCoord.y = screenHeight - pixelCoord.y;\n"
+                                  "   float sum = 0.0;\n"
+                                  "   vec3 tint = vec3(0.0);\n"
+                                  "   for(int i = 0; i < numMetaballs; i++) {\n"
+                                  "       vec4 state = uintBitsToFloat(ballState[2 * i]);\n"
+                                  "       highp uvec4 motion = ballState[2 * i + 1];\n"
+                                  "       vec2 diff = mix(state.zw, state.xy, alpha) - pixelCoord;\n"
+                                  "       float distSquared = dot(diff, diff);\n"
+                                  "       if(distSquared < 0.001) distSquared = 0.001;\n"
+                                  "       float f = uintBitsToFloat(motion.z) / distSquared;\n"
+                                  "       sum += f;\n"
+                                  "       if(tinted) tint += f * unpackTint(motion.w);\n"
+                                  "   }\n"
+                                  "   vec3 color = shadeField(sum);\n"
+                                  "   if(tinted) color *= tint / max(sum, 1e-6);\n"
+                                  "   fragColor = vec4(encodeOutput(color), 1.0);\n"
+                                  "}\n";
+
+static_assert(2 * MAX_METABALLS == 200, "ballState in g_gpuFieldFragmentShader holds two uvec4 per ball");
+
+GLuint GpuSim::CreateStepProgram()
+{
+    GLuint vertex = EGLCore::LoadShader(GL_VERTEX_SHADER, g_gpuStepVertexShader);
+    GLuint fragment = EGLCore::LoadShader(GL_FRAGMENT_SHADER, g_gpuStepFragmentShader);
+    GLuint program = glCreateProgram();
+    if (vertex == 0 || fragment == 0 || program == 0) {
+        return 0;
+    }
+
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    // Interleaved output has the same layout as the input records.
+    const char *varyings[] = {"v_position", "v_motion"};
+    glTransformFeedbackVaryings(program, 2, varyings, GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(program);
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        GLint infoLen = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLen);
+        if (infoLen > 1) {
+            char *infoLog = (char *)malloc(sizeof(char) * infoLen);
+            glGetProgramInfoLog(program, infoLen, nullptr, infoLog);
+            LOGE("GpuSim: step program link error: %{public}s", infoLog);
+            free(infoLog);
+        }
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+bool GpuSim::Init(const MetaballPool &pool)
+{
+    stepProgram_ = CreateStepProgram();
+    fieldProgram_ = EGLCore::CreateProgram(g_gpuFieldVertexShader, g_gpuFieldFragmentShader);
+    GLuint blockIndex = fieldProgram_ ? glGetUniformBlockIndex(fieldProgram_, "BallState") : GL_INVALID_INDEX;
+    if (!stepProgram_ || blockIndex == GL_INVALID_INDEX) {
+        LOGE("GpuSim: could not create programs");
+        FreeGL();
+        return false;
+    }
+    glUniformBlockBinding(fieldProgram_, blockIndex, GPU_SIM_BALL_BINDING);
+
+    glGenBuffers(2, buffers_);
+    glGenVertexArrays(2, vaos_);
+    for (int32_t i = 0; i < 2; i++) {
+        glBindVertexArray(vaos_[i]);
+        glBindBuffer(GL_ARRAY_BUFFER, buffers_[i]);
+        glBufferData(GL_ARRAY_BUFFER, GPU_SIM_BUFFER_BYTES, nullptr, GL_DYNAMIC_COPY);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, GPU_SIM_RECORD_BYTES, reinterpret_cast<void *>(0));
+        glVertexAttribIPointer(1, 4, GL_UNSIGNED_INT, GPU_SIM_RECORD_BYTES,
+                               reinterpret_cast<void *>(4 * sizeof(uint32_t)));
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(1);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glGenBuffers(1, &readbackBuffer_);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, readbackBuffer_);
+    glBufferData(GL_COPY_WRITE_BUFFER, GPU_SIM_BUFFER_BYTES, nullptr, GL_STREAM_READ);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    current_ = 0;
+    edits_.clear();
+    Upload(pool);
+    active_ = true;
+    LOGI("GpuSim initialized with %{public}zu balls", pool.Size());
+    return true;
+}
+
+void GpuSim::Release(MetaballPool &pool)
+{
+    if (active_) {
+        // Hand the simulation back exactly where the GPU left it.
+        ApplyEdits(pool);
+        ReadInto(buffers_[current_], pool);
+    }
+    FreeGL();
+}
+
+void GpuSim::Abandon()
+{
+    readbackFence_ = nullptr;
+    readbackBuffer_ = 0;
+    vaos_[0] = vaos_[1] = 0;
+    buffers_[0] = buffers_[1] = 0;
+    stepProgram_ = 0;
+    fieldProgram_ = 0;
+    edits_.clear();
+    active_ = false;
+}
+
+void GpuSim::FreeGL()
+{
+    if (readbackFence_) {
+        glDeleteSync(readbackFence_);
+        readbackFence_ = nullptr;
+    }
+    if (readbackBuffer_) {
+        glDeleteBuffers(1, &readbackBuffer_);
+        readbackBuffer_ = 0;
+    }
+    if (vaos_[0]) {
+        glDeleteVertexArrays(2, vaos_);
+        glDeleteBuffers(2, buffers_);
+        vaos_[0] = vaos_[1] = 0;
+        buffers_[0] = buffers_[1] = 0;
+    }
+    if (stepProgram_) {
+        glDeleteProgram(stepProgram_);
+        stepProgram_ = 0;
+    }
+    if (fieldProgram_) {
+        glDeleteProgram(fieldProgram_);
+        fieldProgram_ = 0;
+    }
+    edits_.clear();
+    active_ = false;
+}
+
+void GpuSim::PackRecord(const Metaball &mb, uint32_t *record)
+{
+    const float words[7] = {mb.x, mb.y, mb.prevX, mb.prevY, mb.dirX, mb.dirY, mb.strength * mb.radius * mb.radius};
+    memcpy(record, words, sizeof(words));
+    record[7] = mb.color;
+}
+
+void GpuSim::LogAdd(const MetaballPool &pool, MetaballHandle handle)
+{
+    int32_t index = pool.IndexOf(handle);
+    if (!active_ || index < 0) {
+        return;
+    }
+    Edit edit = {EDIT_WRITE, index, 0, {}};
+    PackRecord(pool[index], edit.record);
+    edits_.push_back(edit);
+    expectedRevision_++;
+}
+
+void GpuSim::LogRemove(const MetaballPool &pool, MetaballHandle handle)
+{
+    int32_t index = pool.IndexOf(handle);
+    if (!active_ || index < 0) {
+        return;
+    }
+    // The pool fills the hole with its last ball; do the same to the GPU records.
+    int32_t last = (int32_t)pool.Size() - 1;
+    if (index != last) {
+        edits_.push_back({EDIT_COPY, index, last, {}});
+    }
+    expectedRevision_++;
+}
+
+void GpuSim::LogMove(const MetaballPool &pool, MetaballHandle handle)
+{
+    int32_t index = pool.IndexOf(handle);
+    if (!active_ || index < 0) {
+        return;
+    }
+    // Position half only, so the heading the GPU has bounced into is kept.
+    Edit edit = {EDIT_MOVE, index, 0, {}};
+    PackRecord(pool[index], edit.record);
+    edits_.push_back(edit);
+}
+
+void GpuSim::LogStyle(const MetaballPool &pool, MetaballHandle handle)
+{
+    int32_t index = pool.IndexOf(handle);
+    if (!active_ || index < 0) {
+        return;
+    }
+    Edit edit = {EDIT_STYLE, index, 0, {}};
+    PackRecord(pool[index], edit.record);
+    edits_.push_back(edit);
+}
+
+void GpuSim::ApplyEdits(MetaballPool &pool)
+{
+    if (readbackFence_) {
+        GLenum result = glClientWaitSync(readbackFence_, 0, 0);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+            glDeleteSync(readbackFence_);
+            readbackFence_ = nullptr;
+            // Stale if the dense order changed since, if an edit was replayed onto the GPU state
+            // after the copy was queued, or if one is still waiting to be.
+            if (readbackRevision_ == pool.Revision() && readbackSequence_ == editSequence_ && edits_.empty()) {
+                ReadInto(readbackBuffer_, pool);
+            }
+        }
+    }
+
+    GLuint buffer = buffers_[current_];
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    for (const Edit &edit : edits_) {
+        GLintptr offset = (GLintptr)edit.index * GPU_SIM_RECORD_BYTES;
+        if (edit.type == EDIT_WRITE) {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, offset, GPU_SIM_RECORD_BYTES, edit.record);
+        } else if (edit.type == EDIT_MOVE) {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, offset, 4 * sizeof(uint32_t), edit.record);
+        } else if (edit.type == EDIT_STYLE) {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, offset + GPU_SIM_STYLE_OFFSET, 2 * sizeof(uint32_t),
+                            &edit.record[6]);
+        } else {
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)edit.source * GPU_SIM_RECORD_BYTES,
+                                offset, GPU_SIM_RECORD_BYTES);
+        }
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    if (!edits_.empty()) {
+        editSequence_++;
+    }
+    edits_.clear();
+
+    if (expectedRevision_ != pool.Revision()) {
+        // Something restructured the pool without going through the log.
+        Upload(pool);
+    }
+}
+
+void GpuSim::Upload(const MetaballPool &pool)
+{
+    uint32_t records[MAX_METABALLS * GPU_SIM_RECORD_WORDS];
+    for (size_t i = 0; i < pool.Size(); i++) {
+        PackRecord(pool[i], &records[i * GPU_SIM_RECORD_WORDS]);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffers_[current_]);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, 0, pool.Size() * GPU_SIM_RECORD_BYTES, records);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    expectedRevision_ = pool.Revision();
+    editSequence_++;
+}
+
+void GpuSim::ReadInto(GLuint buffer, MetaballPool &pool)
+{
+    size_t bytes = pool.Size() * GPU_SIM_RECORD_BYTES;
+    if (bytes == 0) {
+        return;
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    const float *records = static_cast<const float *>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, bytes, GL_MAP_READ_BIT));
+    if (records) {
+        for (size_t i = 0; i < pool.Size(); i++) {
+            // Style words are only ever written from the pool, so there is nothing to copy back.
+            const float *record = &records[i * GPU_SIM_RECORD_WORDS];
+            Metaball &mb = pool[i];
+            mb.x = record[0];
+            mb.y = record[1];
+            mb.prevX = record[2];
+            mb.prevY = record[3];
+            mb.dirX = record[4];
+            mb.dirY = record[5];
+        }
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+    } else {
+        LOGE("GpuSim: glMapBufferRange failed");
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+void GpuSim::Step(int32_t count, int32_t steps, float speed, float screenWidth, float screenHeight)
+{
+    if (count == 0 || steps == 0) {
+        return;
+    }
+    int32_t next = 1 - current_;
+    glUseProgram(stepProgram_);
+    glUniform1i(glGetUniformLocation(stepProgram_, "steps"), steps);
+    glUniform1f(glGetUniformLocation(stepProgram_, "speed"), speed);
+    glUniform2f(glGetUniformLocation(stepProgram_, "bounds"), screenWidth, screenHeight);
+
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(vaos_[current_]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, buffers_[next]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, count);
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    // The field pass draws from client-side arrays, which only the default VAO allows.
+    glBindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+    current_ = next;
+}
+
+void GpuSim::QueueReadback(uint32_t revision)
+{
+    if (readbackFence_) {
+        return;
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, buffers_[current_]);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, readbackBuffer_);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, GPU_SIM_BUFFER_BYTES);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    readbackFence_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readbackRevision_ = revision;
+    readbackSequence_ = editSequence_;
+}
+
+void GpuSim::UseFieldProgram(int32_t count, float alpha, float scaleX, float scaleY, bool tinted, float screenHeight,
+                             const IsoPalette &palette)
+{
+    glUseProgram(fieldProgram_);
+    glBindBufferBase(GL_UNIFORM_BUFFER, GPU_SIM_BALL_BINDING, buffers_[current_]);
+    glUniform1i(glGetUniformLocation(fieldProgram_, "numMetaballs"), count);
+    glUniform1f(glGetUniformLocation(fieldProgram_, "alpha"), alpha);
+    glUniform1f(glGetUniformLocation(fieldProgram_, "screenHeight"), screenHeight);
+    glUniform1i(glGetUniformLocation(fieldProgram_, "tinted"), tinted ? 1 : 0);
+    glUniform2f(glGetUniformLocation(fieldProgram_, "pixelScale"), scaleX, scaleY);
+    palette.Apply(fieldProgram_);
+}
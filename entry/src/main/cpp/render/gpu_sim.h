@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GPU_SIM_H
+#define GPU_SIM_H
+
+#include <cstdint>
+#include <vector>
+#include <GLES3/gl3.h>
+#include "render/metaball_pool.h"
+
+class IsoPalette;
+
+/**
+ * GPU-resident simulation mode.
+ * Ball state lives in two buffers of GPU_SIM_RECORD_WORDS words per ball,
+ * floats (x, y, prevX, prevY, dirX, dirY, strength * radius^2) then the RGBA8
+ * tint, in the pool's dense order.
+ * Step() runs every fixed step of the frame in one transform-feedback pass from
+ * one buffer into the other, with the same integration and bounce as
+ * UpdateMetaballs, and the field shader reads the result as a uniform block, so
+ * nothing per ball is uploaded in steady state.
+ * g_metaballs stays the authority for membership: adds, removes, moves and
+ * style changes are logged as they happen and replayed as small buffer
+ * sub-updates and copies; structural changes that were not logged (snapshots,
+ * clears) trigger a full upload. The CPU copy of the positions, used by hit testing and events, is
+ * refreshed through a fenced readback and trails by a frame or two.
+ * Log* and ApplyEdits expect g_metaballMutex to be held; the rest runs on the
+ * render thread with the context current.
+ */
+class GpuSim {
+public:
+    // Needs the pool's current contents; they are uploaded as the initial state.
+    bool Init(const MetaballPool &pool);
+    // Writes the final GPU state back into pool, then frees the GL objects.
+    void Release(MetaballPool &pool);
+    // The context is going away with the objects in it: only drops the bookkeeping.
+    void Abandon();
+    bool Active() const { return active_; }
+
+    void LogAdd(const MetaballPool &pool, MetaballHandle handle);
+    // Call before the pool removes the ball, while its dense index is still known.
+    void LogRemove(const MetaballPool &pool, MetaballHandle handle);
+    void LogMove(const MetaballPool &pool, MetaballHandle handle);
+    // Radius, strength or color changed; rewrites the weight and tint words only.
+    void LogStyle(const MetaballPool &pool, MetaballHandle handle);
+
+    // Copies a finished readback into pool, then replays the edit log onto the GPU state.
+    void ApplyEdits(MetaballPool &pool);
+    void Step(int32_t count, int32_t steps, float speed, float screenWidth, float screenHeight);
+    // Starts copying the current state out for a later ApplyEdits, unless a copy is still in flight.
+    // The copy is only used if no edit reached the GPU state after it was queued.
+    void QueueReadback(uint32_t revision);
+    void UseFieldProgram(int32_t count, float alpha, float scaleX, float scaleY, bool tinted, float screenHeight,
+                         const IsoPalette &palette);
+
+private:
+    enum EditType {
+        EDIT_WRITE,
+        EDIT_COPY,
+        EDIT_MOVE,
+        EDIT_STYLE,
+    };
+
+    struct Edit {
+        EditType type;
+        int32_t index;
+        int32_t source;
+        uint32_t record[8];
+    };
+
+    static void PackRecord(const Metaball &mb, uint32_t *record);
+    static GLuint CreateStepProgram();
+    void FreeGL();
+    void Upload(const MetaballPool &pool);
+    void ReadInto(GLuint buffer, MetaballPool &pool);
+
+    GLuint stepProgram_ = 0;
+    GLuint fieldProgram_ = 0;
+    GLuint buffers_[2] = {0, 0};
+    GLuint vaos_[2] = {0, 0};
+    GLuint readbackBuffer_ = 0;
+    GLsync readbackFence_ = nullptr;
+    uint32_t readbackRevision_ = 0;
+    // Bumped whenever ApplyEdits or Upload writes to the GPU state. A readback stamped with an
+    // older value copied the state before those writes and would undo them.
+    uint32_t editSequence_ = 0;
+    uint32_t readbackSequence_ = 0;
+    // Index of the buffer holding the latest state.
+    int32_t current_ = 0;
+    bool active_ = false;
+    // Pool revision the GPU state corresponds to once the log is replayed.
+    uint32_t expectedRevision_ = 0;
+    std::vector<Edit> edits_;
+};
+
+#endif // GPU_SIM_H
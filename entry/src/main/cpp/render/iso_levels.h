@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ISO_LEVELS_H
+#define ISO_LEVELS_H
+
+#include <cmath>
+
+#define ISO_LEVEL_HALO_DEFAULT 0.5f
+#define ISO_LEVEL_INSIDE_DEFAULT 1.0f
+// Below this a handful of default balls floods a watch-sized panel with the halo band.
+#define ISO_LEVEL_MIN 0.1f
+// Matches FIELD_CLAMP: a clamped contribution must still clear every isolevel.
+#define ISO_LEVEL_MAX 4.0f
+#define ISO_PALETTE_SIZE 3
+
+// Field sums at which the halo and inside bands start. Shared by every renderer and the hit tester.
+struct IsoLevels {
+    float halo = ISO_LEVEL_HALO_DEFAULT;
+    float inside = ISO_LEVEL_INSIDE_DEFAULT;
+
+    bool Valid() const
+    {
+        return std::isfinite(halo) && std::isfinite(inside) && halo >= ISO_LEVEL_MIN && halo < inside &&
+               inside <= ISO_LEVEL_MAX;
+    }
+};
+
+// Linear RGB per band: outside, halo, inside.
+constexpr float ISO_PALETTE[ISO_PALETTE_SIZE][3] = {
+    {0.0f, 0.0f, 0.0f},
+    {0.05f, 0.4f, 0.6f},
+    {0.1f, 0.8f, 0.9f},
+};
+
+#endif // ISO_LEVELS_H
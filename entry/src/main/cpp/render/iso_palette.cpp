@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hilog/log.h>
+#include <cmath>
+#include "render/iso_palette.h"
+#include "common/native_common.h"
+
+bool IsoPalette::Init()
+{
+    float texels[4 * ISO_PALETTE_SIZE];
+    for (int32_t i = 0; i < ISO_PALETTE_SIZE; i++) {
+        texels[4 * i] = ISO_PALETTE[i][0];
+        texels[4 * i + 1] = ISO_PALETTE[i][1];
+        texels[4 * i + 2] = ISO_PALETTE[i][2];
+        texels[4 * i + 3] = 1.0f;
+    }
+
+    glGenTextures(1, &texture_);
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, ISO_PALETTE_SIZE, 1, 0, GL_RGBA, GL_FLOAT, texels);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (glGetError() != GL_NO_ERROR) {
+        LOGE("IsoPalette: could not create the palette texture");
+        Release();
+        return false;
+    }
+    return true;
+}
+
+void IsoPalette::Release()
+{
+    if (texture_) {
+        glDeleteTextures(1, &texture_);
+        texture_ = 0;
+    }
+}
+
+void IsoPalette::SetSurfaceSrgb(bool srgb)
+{
+    surfaceSrgb_ = srgb;
+    for (int32_t i = 0; i < ISO_PALETTE_SIZE; i++) {
+        for (int32_t c = 0; c < 3; c++) {
+            float linear = ISO_PALETTE[i][c];
+            float encoded = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+            surfaceColors_[i][c] = srgb ? linear : encoded;
+        }
+    }
+}
+
+void IsoPalette::Apply(GLuint program) const
+{
+    glActiveTexture(GL_TEXTURE0 + ISO_PALETTE_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glActiveTexture(GL_TEXTURE0);
+
+    GLint paletteLoc = glGetUniformLocation(program, "paletteTexture");
+    glUniform1i(paletteLoc, ISO_PALETTE_TEXTURE_UNIT);
+
+    GLint levelsLoc = glGetUniformLocation(program, "isoLevels");
+    glUniform2f(levelsLoc, levels_.halo, levels_.inside);
+
+    GLint antialiasLoc = glGetUniformLocation(program, "edgeAntialias");
+    glUniform1i(antialiasLoc, antialias_ ? 1 : 0);
+
+    GLint encodeLoc = glGetUniformLocation(program, "encodeSrgb");
+    glUniform1i(encodeLoc, surfaceSrgb_ ? 0 : 1);
+}
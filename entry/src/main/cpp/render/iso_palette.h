@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ISO_PALETTE_H
+#define ISO_PALETTE_H
+
+#include <GLES3/gl3.h>
+#include "render/iso_levels.h"
+
+// Texture unit the palette LUT is bound to while a field pass shades.
+#define ISO_PALETTE_TEXTURE_UNIT 1
+
+// Appended to every fragment shader that turns a field sum into a color.
+// With edgeAntialias set, each isoline is blended over one pixel of screen space,
+// measured from the field's gradient, instead of a hard step. The ramp runs on
+// log(sum): same isolines, but no false edges near ball centers where the raw
+// sum is far too steep for a one-pixel linearization. encodeOutput is the last
+// step of every such shader: it applies the sRGB curve when the target surface
+// is linear, so 565 and non-sRGB surfaces show the same colors.
+#define ISO_SHADE_GLSL                                                                   \
+    "uniform sampler2D paletteTexture;\n"                                                \
+    "uniform vec2 isoLevels;\n"                                                          \
+    "uniform bool edgeAntialias;\n"                                                      \
+    "uniform bool encodeSrgb;\n"                                                         \
+    "vec3 shadeField(float sum)\n"                                                       \
+    "{\n"                                                                                \
+    "   float logSum = log(max(sum, 1e-6));\n"                                           \
+    "   float edgeWidth = max(length(vec2(dFdx(logSum), dFdy(logSum))), 1e-6);\n"        \
+    "   vec2 coverage = edgeAntialias\n"                                                 \
+    "       ? clamp((vec2(logSum) - log(isoLevels)) / edgeWidth + 0.5, 0.0, 1.0)\n"      \
+    "       : step(isoLevels, vec2(sum));\n"                                             \
+    "   vec3 color = texelFetch(paletteTexture, ivec2(0, 0), 0).rgb;\n"                  \
+    "   color = mix(color, texelFetch(paletteTexture, ivec2(1, 0), 0).rgb, coverage.x);\n" \
+    "   color = mix(color, texelFetch(paletteTexture, ivec2(2, 0), 0).rgb, coverage.y);\n" \
+    "   return color;\n"                                                                 \
+    "}\n"                                                                                \
+    "vec3 encodeOutput(vec3 color)\n"                                                    \
+    "{\n"                                                                                \
+    "   if(!encodeSrgb) return color;\n"                                                 \
+    "   vec3 curve = 1.055 * pow(color, vec3(1.0 / 2.4)) - 0.055;\n"                     \
+    "   return mix(curve, color * 12.92, vec3(lessThanEqual(color, vec3(0.0031308))));\n" \
+    "}\n"
+
+// Decodes a ball's RGBA8 tint (red in the low byte) to linear [0, 1] RGB.
+// ES 3.00 has no unpackUnorm4x8, so the bytes are split by hand, in highp:
+// fragment ints default to mediump, which may be 16 bits wide.
+#define ISO_TINT_GLSL                                                                    \
+    "vec3 unpackTint(highp uint color)\n"                                                \
+    "{\n"                                                                                \
+    "   highp uvec3 bytes = (uvec3(color) >> uvec3(0u, 8u, 16u)) & 0xFFu;\n"             \
+    "   return vec3(bytes) / 255.0;\n"                                                   \
+    "}\n"
+
+/**
+ * Palette lookup texture and isolevel uniforms for ISO_SHADE_GLSL.
+ * The LUT holds ISO_PALETTE as half floats, so the linear colors reach the
+ * surface unquantized; on a linear surface the shader encodes them instead.
+ */
+class IsoPalette {
+public:
+    IsoPalette() { SetSurfaceSrgb(true); }
+    bool Init();
+    // Context must be current.
+    void Release();
+    // The context is going away with the texture in it: only forgets the name.
+    void Abandon() { texture_ = 0; }
+    void SetLevels(const IsoLevels &levels) { levels_ = levels; }
+    void SetAntialias(bool enabled) { antialias_ = enabled; }
+    // Whether the current render target encodes sRGB on write.
+    void SetSurfaceSrgb(bool srgb);
+    // ISO_PALETTE[band] as the render target should receive it, for clears and flat fills.
+    const float *SurfaceColor(int32_t band) const { return surfaceColors_[band]; }
+    // program must be current; binds the LUT and uploads the shading uniforms.
+    void Apply(GLuint program) const;
+
+private:
+    GLuint texture_ = 0;
+    IsoLevels levels_;
+    bool antialias_ = true;
+    bool surfaceSrgb_ = true;
+    float surfaceColors_[ISO_PALETTE_SIZE][3];
+};
+
+#endif // ISO_PALETTE_H
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include "render/metaball_pool.h"
+
+#define HANDLE_SLOT_BITS 16
+#define HANDLE_SLOT_MASK 0xFFFFu
+
+MetaballPool::MetaballPool() : freeCount_(0), size_(0), revision_(0)
+{
+    for (uint32_t i = 0; i < CAPACITY; i++) {
+        generation_[i] = 1;
+        slotToDense_[i] = 0;
+        denseToSlot_[i] = 0;
+    }
+    Clear();
+}
+
+MetaballHandle MetaballPool::Add(const Metaball &ball)
+{
+    if (freeCount_ == 0) {
+        return INVALID_METABALL_HANDLE;
+    }
+
+    uint16_t slot = freeSlots_[--freeCount_];
+    uint32_t index = size_++;
+    dense_[index] = ball;
+    denseToSlot_[index] = slot;
+    slotToDense_[slot] = (uint16_t)index;
+    revision_++;
+    return ((MetaballHandle)generation_[slot] << HANDLE_SLOT_BITS) | (MetaballHandle)(slot + 1);
+}
+
+bool MetaballPool::Remove(MetaballHandle handle)
+{
+    int32_t slot = SlotOf(handle);
+    if (slot < 0) {
+        return false;
+    }
+
+    // Swap the last live ball into the hole to keep the dense range packed.
+    uint32_t index = slotToDense_[slot];
+    uint32_t last = --size_;
+    if (index != last) {
+        dense_[index] = dense_[last];
+        denseToSlot_[index] = denseToSlot_[last];
+        slotToDense_[denseToSlot_[index]] = (uint16_t)index;
+    }
+
+    // Bump the generation so stale handles to this slot stop resolving; skip 0 on wrap.
+    if (++generation_[slot] == 0) {
+        generation_[slot] = 1;
+    }
+    freeSlots_[freeCount_++] = (uint16_t)slot;
+    revision_++;
+    return true;
+}
+
+Metaball *MetaballPool::Get(MetaballHandle handle)
+{
+    int32_t slot = SlotOf(handle);
+    return slot < 0 ? nullptr : &dense_[slotToDense_[slot]];
+}
+
+void MetaballPool::Clear()
+{
+    // Every slot that was live gets a new generation, invalidating outstanding handles.
+    for (uint32_t i = 0; i < size_; i++) {
+        uint16_t slot = denseToSlot_[i];
+        if (++generation_[slot] == 0) {
+            generation_[slot] = 1;
+        }
+    }
+    size_ = 0;
+    freeCount_ = CAPACITY;
+    revision_++;
+    // Hand out low slots first so a fresh scene gets small, predictable handles.
+    for (uint32_t i = 0; i < CAPACITY; i++) {
+        freeSlots_[i] = (uint16_t)(CAPACITY - 1 - i);
+    }
+}
+
+void MetaballPool::RestoreFrom(const MetaballPool &snapshot)
+{
+    uint32_t revision = revision_;
+    uint16_t current[CAPACITY];
+    std::copy_n(generation_, CAPACITY, current);
+    *this = snapshot;
+    revision_ = revision + 1;
+
+    // Live slots keep the saved generation so the saved handles resolve again. Free slots must not
+    // go back, or a handle issued after the save would resolve once a later Add reached its
+    // generation again: they move one past the newer of the two.
+    bool live[CAPACITY] = {};
+    for (uint32_t i = 0; i < size_; i++) {
+        live[denseToSlot_[i]] = true;
+    }
+    for (uint32_t slot = 0; slot < CAPACITY; slot++) {
+        if (live[slot]) {
+            continue;
+        }
+        generation_[slot] = std::max(generation_[slot], current[slot]);
+        if (++generation_[slot] == 0) {
+            generation_[slot] = 1;
+        }
+    }
+}
+
+bool MetaballPool::IsConsistent() const
+{
+    if (size_ > CAPACITY || freeCount_ != CAPACITY - size_) {
+        return false;
+    }
+    // Every slot must be either live exactly once or free exactly once.
+    bool seen[CAPACITY] = {};
+    for (uint32_t i = 0; i < size_; i++) {
+        uint16_t slot = denseToSlot_[i];
+        if (slot >= CAPACITY || seen[slot] || slotToDense_[slot] != i) {
+            return false;
+        }
+        seen[slot] = true;
+    }
+    for (uint32_t i = 0; i < freeCount_; i++) {
+        uint16_t slot = freeSlots_[i];
+        if (slot >= CAPACITY || seen[slot]) {
+            return false;
+        }
+        seen[slot] = true;
+    }
+    // Generations skip 0 on wrap, so a 0 here was never written by this class.
+    for (uint32_t i = 0; i < CAPACITY; i++) {
+        if (generation_[i] == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+MetaballHandle MetaballPool::HandleAt(size_t i) const
+{
+    uint16_t slot = denseToSlot_[i];
+    return ((MetaballHandle)generation_[slot] << HANDLE_SLOT_BITS) | (MetaballHandle)(slot + 1);
+}
+
+int32_t MetaballPool::IndexOf(MetaballHandle handle) const
+{
+    int32_t slot = SlotOf(handle);
+    return slot < 0 ? -1 : (int32_t)slotToDense_[slot];
+}
+
+int32_t MetaballPool::SlotOf(MetaballHandle handle) const
+{
+    uint32_t slotPlusOne = handle & HANDLE_SLOT_MASK;
+    if (slotPlusOne == 0 || slotPlusOne > CAPACITY) {
+        return -1;
+    }
+    uint32_t slot = slotPlusOne - 1;
+    if (generation_[slot] != (uint16_t)(handle >> HANDLE_SLOT_BITS)) {
+        return -1;
+    }
+    // Sparse-set membership check: rejects forged handles that name a free slot.
+    uint32_t index = slotToDense_[slot];
+    if (index >= size_ || denseToSlot_[index] != slot) {
+        return -1;
+    }
+    return (int32_t)slot;
+}
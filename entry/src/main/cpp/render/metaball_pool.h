@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef METABALL_POOL_H
+#define METABALL_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define MAX_METABALLS 100
+// RGBA8 in memory order (red in the low byte), the layout the shaders unpack.
+#define METABALL_WHITE 0xFFFFFFFFu
+
+struct Metaball {
+    float x, y;
+    // Position before the last simulation step, used for render interpolation.
+    float prevX, prevY;
+    float dirX, dirY;
+    float radius;
+    // The ball adds strength * radius^2 / d^2 to the field.
+    float strength = 1.0f;
+    // Multiplies the band color wherever this ball dominates the field.
+    uint32_t color = METABALL_WHITE;
+};
+
+// Handle layout: high 16 bits generation, low 16 bits slot index + 1.
+// 0 is never handed out, so JS can use it as "no ball".
+using MetaballHandle = uint32_t;
+constexpr MetaballHandle INVALID_METABALL_HANDLE = 0;
+
+/**
+ * Fixed-capacity metaball storage.
+ * Live balls stay densely packed in [0, Size()) so the per-frame loops can walk
+ * them linearly; a slot table maps stable handles to dense indices. Add, Remove,
+ * and Get are O(1) and never allocate.
+ */
+class MetaballPool {
+public:
+    static constexpr uint32_t CAPACITY = MAX_METABALLS;
+
+    MetaballPool();
+
+    MetaballHandle Add(const Metaball &ball);
+    bool Remove(MetaballHandle handle);
+    Metaball *Get(MetaballHandle handle);
+    void Clear();
+    // Takes over a snapshot's contents; counts as a structural change. Handles live in the
+    // snapshot resolve again, and no handle this pool issued to a free slot ever does.
+    // Only pass a pool that IsConsistent(): the tables are trusted as they are.
+    void RestoreFrom(const MetaballPool &snapshot);
+    // Whether the counts and the slot, dense and free tables agree, as Add/Remove keep them.
+    // For pools that came from outside, e.g. a snapshot file; ball contents are not checked.
+    bool IsConsistent() const;
+
+    size_t Size() const { return size_; }
+    bool Full() const { return size_ >= CAPACITY; }
+    Metaball &operator[](size_t i) { return dense_[i]; }
+    const Metaball &operator[](size_t i) const { return dense_[i]; }
+    MetaballHandle HandleAt(size_t i) const;
+    // Dense index of a live ball, or -1 for a stale or forged handle. O(1), like Get.
+    int32_t IndexOf(MetaballHandle handle) const;
+    // Bumped whenever the dense order changes (add, remove, clear); moves do not count.
+    uint32_t Revision() const { return revision_; }
+
+private:
+    int32_t SlotOf(MetaballHandle handle) const;
+
+    Metaball dense_[CAPACITY];
+    uint16_t denseToSlot_[CAPACITY];
+    uint16_t slotToDense_[CAPACITY];
+    uint16_t generation_[CAPACITY];
+    uint16_t freeSlots_[CAPACITY];
+    uint32_t freeCount_;
+    uint32_t size_;
+    uint32_t revision_;
+};
+
+#endif // METABALL_POOL_H
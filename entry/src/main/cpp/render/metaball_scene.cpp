@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hilog/log.h>
+#include <cmath>
+#include <cstring>
+#include "render/event_channel.h"
+#include "render/metaball_scene.h"
+#include "common/native_common.h"
+
+#define PI 3.1416f
+
+MetaballPool g_metaballs;
+float g_metaballPositions[2 * MAX_METABALLS] = {0};
+float g_metaballWeights[MAX_METABALLS] = {0};
+uint32_t g_metaballColors[MAX_METABALLS] = {0};
+std::mt19937 g_rng;
+IsoLevels g_isoLevels;
+// Guards g_metaballs and g_isoLevels: NAPI calls arrive on the JS thread, the render loop runs on the VSync thread.
+std::mutex g_metaballMutex;
+
+void InitMetaballs()
+{
+    std::lock_guard<std::mutex> lock(g_metaballMutex);
+    g_metaballs.Clear();
+    g_rng.seed(std::random_device{}());
+    LOGI("Metaballs initialized");
+}
+
+MetaballHandle AddMetaball(float x, float y, float screenWidth, float screenHeight, float radius)
+{
+    std::lock_guard<std::mutex> lock(g_metaballMutex);
+    return AddMetaballLocked(x, y, screenWidth, screenHeight, radius);
+}
+
+MetaballHandle AddMetaballLocked(float x, float y, float screenWidth, float screenHeight, float radius)
+{
+    if (g_metaballs.Full()) {
+        LOGW("Maximum metaballs reached");
+        g_renderEvents.PostCapacityReached();
+        return INVALID_METABALL_HANDLE;
+    }
+
+    std::uniform_real_distribution<float> angleDist(0, 2.0f * PI);
+    float angle = angleDist(g_rng);
+
+    Metaball mb;
+    mb.x = x;
+    mb.y = y;
+    mb.prevX = x;
+    mb.prevY = y;
+    mb.dirX = std::cos(angle);
+    mb.dirY = std::sin(angle);
+    mb.radius = radius;
+
+    MetaballHandle handle = g_metaballs.Add(mb);
+    LOGI("Metaball added at (%{public}f, %{public}f), total: %{public}zu", x, y, g_metaballs.Size());
+    return handle;
+}
+
+void UpdateMetaballs(float screenWidth, float screenHeight, float speed)
+{
+    for (size_t i = 0; i < g_metaballs.Size(); i++) {
+        g_metaballs[i].prevX = g_metaballs[i].x;
+        g_metaballs[i].prevY = g_metaballs[i].y;
+        g_metaballs[i].x += g_metaballs[i].dirX * speed;
+        g_metaballs[i].y += g_metaballs[i].dirY * speed;
+
+        if (g_metaballs[i].x >= screenWidth || g_metaballs[i].x <= 0) {
+            g_metaballs[i].dirX *= -1.0f;
+        }
+        if (g_metaballs[i].y >= screenHeight || g_metaballs[i].y <= 0) {
+            g_metaballs[i].dirY *= -1.0f;
+        }
+    }
+}
+
+void AttractMetaballs(BarnesHut &solver, float strength, float stepSeconds)
+{
+    // SoA scratch for the solver; only touched under g_metaballMutex.
+    static float x[MAX_METABALLS];
+    static float y[MAX_METABALLS];
+    static float mass[MAX_METABALLS];
+    static float ax[MAX_METABALLS];
+    static float ay[MAX_METABALLS];
+    int32_t count = (int32_t)g_metaballs.Size();
+    for (int32_t i = 0; i < count; i++) {
+        const Metaball &mb = g_metaballs[i];
+        x[i] = mb.x;
+        y[i] = mb.y;
+        // The field weight PackMetaballPositions uploads, so a ball pulls as hard as it shows;
+        // a default ball weighs 1.
+        mass[i] = mb.strength * mb.radius * mb.radius / (METABALL_DEFAULT_RADIUS * METABALL_DEFAULT_RADIUS);
+    }
+    // Softened by one default radius so overlapping balls do not slingshot.
+    solver.Compute(x, y, mass, count, strength, METABALL_DEFAULT_RADIUS, ax, ay);
+
+    for (int32_t i = 0; i < count; i++) {
+        Metaball &mb = g_metaballs[i];
+        float vx = mb.dirX * METABALL_SPEED_PX_PER_SECOND + ax[i] * stepSeconds;
+        float vy = mb.dirY * METABALL_SPEED_PX_PER_SECOND + ay[i] * stepSeconds;
+        float length = std::sqrt(vx * vx + vy * vy);
+        if (length > 1e-3f) {
+            mb.dirX = vx / length;
+            mb.dirY = vy / length;
+        }
+    }
+}
+
+void PackMetaballPositions(float alpha)
+{
+    for (size_t i = 0; i < g_metaballs.Size(); i++) {
+        const Metaball &mb = g_metaballs[i];
+        g_metaballPositions[2 * i] = mb.prevX + (mb.x - mb.prevX) * alpha;
+        g_metaballPositions[2 * i + 1] = mb.prevY + (mb.y - mb.prevY) * alpha;
+        g_metaballWeights[i] = mb.strength * mb.radius * mb.radius;
+        g_metaballColors[i] = mb.color;
+    }
+}
+
+void PackMetaballUniforms(uint32_t *uniforms, int32_t count)
+{
+    for (int32_t i = 0; i < count; i++) {
+        memcpy(&uniforms[4 * i], &g_metaballPositions[2 * i], 2 * sizeof(float));
+        memcpy(&uniforms[4 * i + 2], &g_metaballWeights[i], sizeof(float));
+        uniforms[4 * i + 3] = g_metaballColors[i];
+    }
+}
+
+bool MetaballsTinted(int32_t count)
+{
+    for (int32_t i = 0; i < count; i++) {
+        if (g_metaballColors[i] != METABALL_WHITE) {
+            return true;
+        }
+    }
+    return false;
+}
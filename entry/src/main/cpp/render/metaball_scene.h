@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef METABALL_SCENE_H
+#define METABALL_SCENE_H
+
+#include <mutex>
+#include <random>
+#include "render/barnes_hut.h"
+#include "render/iso_levels.h"
+#include "render/metaball_pool.h"
+
+#define METABALL_DEFAULT_RADIUS 25.0f
+// 2 px per frame at 60 Hz, now independent of the display rate.
+#define METABALL_SPEED_PX_PER_SECOND 120.0f
+// Upper bound for the attraction strength G, in px^3/s^2; 0 turns attraction off.
+#define METABALL_MAX_ATTRACTION 1.0e8f
+#define METABALL_MIN_RADIUS 2.0f
+#define METABALL_MAX_RADIUS 120.0f
+#define METABALL_MAX_STRENGTH 8.0f
+
+// Simulation state shared by the GL and software render paths.
+extern MetaballPool g_metaballs;
+extern float g_metaballPositions[2 * MAX_METABALLS];
+// Per-ball strength * radius^2 and RGBA8 tint, packed alongside the positions.
+extern float g_metaballWeights[MAX_METABALLS];
+extern uint32_t g_metaballColors[MAX_METABALLS];
+extern std::mt19937 g_rng;
+extern IsoLevels g_isoLevels;
+extern std::mutex g_metaballMutex;
+
+void InitMetaballs();
+MetaballHandle AddMetaball(float x, float y, float screenWidth, float screenHeight, float radius);
+// AddMetaball for callers that already hold g_metaballMutex.
+MetaballHandle AddMetaballLocked(float x, float y, float screenWidth, float screenHeight, float radius);
+// Advances one fixed simulation step; speed is the distance covered in that step.
+void UpdateMetaballs(float screenWidth, float screenHeight, float speed);
+// Turns each ball's heading toward the others' pull for one step; speed stays constant. Mass scales with area.
+void AttractMetaballs(BarnesHut &solver, float strength, float stepSeconds);
+// Writes render positions interpolated between the last two steps into g_metaballPositions,
+// and each ball's field weight and tint into g_metaballWeights and g_metaballColors.
+void PackMetaballPositions(float alpha);
+// Interleaves the packed arrays into metaballArray's layout: x, y, weight (float bits), tint.
+void PackMetaballUniforms(uint32_t *uniforms, int32_t count);
+// True if any of the first count packed balls has a tint other than white.
+bool MetaballsTinted(int32_t count);
+
+#endif // METABALL_SCENE_H
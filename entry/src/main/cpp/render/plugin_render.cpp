@@ -13,11 +13,14 @@
  * limitations under the License.
  */
 
+#include <climits>
 #include <cstdint>
 #include <hilog/log.h>
 #include "common/native_common.h"
 #include "manager/plugin_manager.h"
+#include "render/event_channel.h"
 #include "render/plugin_render.h"
+#include "render/scene_snapshot.h"
 
 
 std::unordered_map<std::string, PluginRender *> PluginRender::instance_;
@@ -177,7 +180,29 @@ napi_value PluginRender::Export(napi_env env, napi_value exports)
 
     napi_property_descriptor desc[] = {
         DECLARE_NAPI_FUNCTION("addMetaball", PluginRender::NapiAddMetaball),
+        DECLARE_NAPI_FUNCTION("removeMetaball", PluginRender::NapiRemoveMetaball),
+        DECLARE_NAPI_FUNCTION("moveMetaball", PluginRender::NapiMoveMetaball),
+        DECLARE_NAPI_FUNCTION("setMetaballRadius", PluginRender::NapiSetMetaballRadius),
+        DECLARE_NAPI_FUNCTION("setMetaballStrength", PluginRender::NapiSetMetaballStrength),
+        DECLARE_NAPI_FUNCTION("setMetaballColor", PluginRender::NapiSetMetaballColor),
         DECLARE_NAPI_FUNCTION("clearMetaballs", PluginRender::NapiClearMetaballs),
+        DECLARE_NAPI_FUNCTION("setIncrementalField", PluginRender::NapiSetIncrementalField),
+        DECLARE_NAPI_FUNCTION("setGpuSimulation", PluginRender::NapiSetGpuSimulation),
+        DECLARE_NAPI_FUNCTION("setIsoLevels", PluginRender::NapiSetIsoLevels),
+        DECLARE_NAPI_FUNCTION("setEdgeAntialiasing", PluginRender::NapiSetEdgeAntialiasing),
+        DECLARE_NAPI_FUNCTION("setBlockCulling", PluginRender::NapiSetBlockCulling),
+        DECLARE_NAPI_FUNCTION("setAttraction", PluginRender::NapiSetAttraction),
+        DECLARE_NAPI_FUNCTION("setSurfaceFormat", PluginRender::NapiSetSurfaceFormat),
+        DECLARE_NAPI_FUNCTION("getSurfaceFormat", PluginRender::NapiGetSurfaceFormat),
+        DECLARE_NAPI_FUNCTION("setTimeline", PluginRender::NapiSetTimeline),
+        DECLARE_NAPI_FUNCTION("clearTimeline", PluginRender::NapiClearTimeline),
+        DECLARE_NAPI_FUNCTION("saveScene", PluginRender::NapiSaveScene),
+        DECLARE_NAPI_FUNCTION("loadScene", PluginRender::NapiLoadScene),
+        DECLARE_NAPI_FUNCTION("sampleField", PluginRender::NapiSampleField),
+        DECLARE_NAPI_FUNCTION("hitTest", PluginRender::NapiHitTest),
+        DECLARE_NAPI_FUNCTION("captureScene", PluginRender::NapiCaptureScene),
+        DECLARE_NAPI_FUNCTION("subscribeEvents", PluginRender::NapiSubscribeEvents),
+        DECLARE_NAPI_FUNCTION("unsubscribeEvents", PluginRender::NapiUnsubscribeEvents),
     };
     NAPI_CALL(env, napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc));
     return exports;
@@ -218,13 +243,256 @@ napi_value PluginRender::NapiAddMetaball(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
+    MetaballHandle handle = INVALID_METABALL_HANDLE;
     std::string id("A");
     PluginRender *instance = PluginRender::GetInstance(id);
     if (instance && instance->eglCore_) {
-        instance->eglCore_->AddMetaballAt((float)x, (float)y);
+        handle = instance->eglCore_->AddMetaballAt((float)x, (float)y);
         LOGI("Metaball added at (%{public}f, %{public}f)", x, y);
     }
-    return nullptr;
+
+    napi_value result;
+    NAPI_CALL(env, napi_create_uint32(env, handle, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiRemoveMetaball(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiRemoveMetaball called");
+
+    size_t argc = 2;
+    napi_value args[2] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2) {
+        LOGE("NapiRemoveMetaball: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiRemoveMetaball: unwrap failed");
+        return nullptr;
+    }
+
+    uint32_t handle;
+    status = napi_get_value_uint32(env, args[1], &handle);
+    if (status != napi_ok) {
+        LOGE("NapiRemoveMetaball: failed to get handle");
+        return nullptr;
+    }
+
+    bool removed = false;
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        removed = instance->eglCore_->RemoveMetaball(handle);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, removed, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiMoveMetaball(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiMoveMetaball called");
+
+    size_t argc = 4;
+    napi_value args[4] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 4) {
+        LOGE("NapiMoveMetaball: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiMoveMetaball: unwrap failed");
+        return nullptr;
+    }
+
+    uint32_t handle;
+    status = napi_get_value_uint32(env, args[1], &handle);
+    if (status != napi_ok) {
+        LOGE("NapiMoveMetaball: failed to get handle");
+        return nullptr;
+    }
+
+    double x, y;
+    status = napi_get_value_double(env, args[2], &x);
+    if (status != napi_ok) {
+        LOGE("NapiMoveMetaball: failed to get x coordinate");
+        return nullptr;
+    }
+
+    status = napi_get_value_double(env, args[3], &y);
+    if (status != napi_ok) {
+        LOGE("NapiMoveMetaball: failed to get y coordinate");
+        return nullptr;
+    }
+
+    bool moved = false;
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        moved = instance->eglCore_->MoveMetaball(handle, (float)x, (float)y);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, moved, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiSetMetaballRadius(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSetMetaballRadius called");
+
+    size_t argc = 3;
+    napi_value args[3] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 3) {
+        LOGE("NapiSetMetaballRadius: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSetMetaballRadius: unwrap failed");
+        return nullptr;
+    }
+
+    uint32_t handle;
+    status = napi_get_value_uint32(env, args[1], &handle);
+    if (status != napi_ok) {
+        LOGE("NapiSetMetaballRadius: failed to get handle");
+        return nullptr;
+    }
+
+    double radius;
+    status = napi_get_value_double(env, args[2], &radius);
+    if (status != napi_ok) {
+        LOGE("NapiSetMetaballRadius: failed to get radius");
+        return nullptr;
+    }
+
+    bool applied = false;
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        applied = instance->eglCore_->SetMetaballRadius(handle, (float)radius);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, applied, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiSetMetaballStrength(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSetMetaballStrength called");
+
+    size_t argc = 3;
+    napi_value args[3] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 3) {
+        LOGE("NapiSetMetaballStrength: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSetMetaballStrength: unwrap failed");
+        return nullptr;
+    }
+
+    uint32_t handle;
+    status = napi_get_value_uint32(env, args[1], &handle);
+    if (status != napi_ok) {
+        LOGE("NapiSetMetaballStrength: failed to get handle");
+        return nullptr;
+    }
+
+    double strength;
+    status = napi_get_value_double(env, args[2], &strength);
+    if (status != napi_ok) {
+        LOGE("NapiSetMetaballStrength: failed to get strength");
+        return nullptr;
+    }
+
+    bool applied = false;
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        applied = instance->eglCore_->SetMetaballStrength(handle, (float)strength);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, applied, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiSetMetaballColor(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSetMetaballColor called");
+
+    size_t argc = 3;
+    napi_value args[3] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 3) {
+        LOGE("NapiSetMetaballColor: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSetMetaballColor: unwrap failed");
+        return nullptr;
+    }
+
+    uint32_t handle;
+    status = napi_get_value_uint32(env, args[1], &handle);
+    if (status != napi_ok) {
+        LOGE("NapiSetMetaballColor: failed to get handle");
+        return nullptr;
+    }
+
+    uint32_t color;
+    status = napi_get_value_uint32(env, args[2], &color);
+    if (status != napi_ok) {
+        LOGE("NapiSetMetaballColor: failed to get color");
+        return nullptr;
+    }
+
+    bool applied = false;
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        applied = instance->eglCore_->SetMetaballColor(handle, color);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, applied, &result));
+    return result;
 }
 
 napi_value PluginRender::NapiClearMetaballs(napi_env env, napi_callback_info info)
@@ -257,3 +525,759 @@ napi_value PluginRender::NapiClearMetaballs(napi_env env, napi_callback_info inf
     }
     return nullptr;
 }
+
+napi_value PluginRender::NapiSetIncrementalField(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSetIncrementalField called");
+
+    size_t argc = 2;
+    napi_value args[2] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2) {
+        LOGE("NapiSetIncrementalField: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSetIncrementalField: unwrap failed");
+        return nullptr;
+    }
+
+    bool enabled;
+    status = napi_get_value_bool(env, args[1], &enabled);
+    if (status != napi_ok) {
+        LOGE("NapiSetIncrementalField: failed to get enabled flag");
+        return nullptr;
+    }
+
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        instance->eglCore_->SetIncrementalField(enabled);
+    }
+    return nullptr;
+}
+
+napi_value PluginRender::NapiSetGpuSimulation(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSetGpuSimulation called");
+
+    size_t argc = 2;
+    napi_value args[2] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2) {
+        LOGE("NapiSetGpuSimulation: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSetGpuSimulation: unwrap failed");
+        return nullptr;
+    }
+
+    bool enabled;
+    status = napi_get_value_bool(env, args[1], &enabled);
+    if (status != napi_ok) {
+        LOGE("NapiSetGpuSimulation: failed to get enabled flag");
+        return nullptr;
+    }
+
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        instance->eglCore_->SetGpuSimulation(enabled);
+    }
+    return nullptr;
+}
+
+napi_value PluginRender::NapiSetIsoLevels(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSetIsoLevels called");
+
+    size_t argc = 3;
+    napi_value args[3] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 3) {
+        LOGE("NapiSetIsoLevels: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSetIsoLevels: unwrap failed");
+        return nullptr;
+    }
+
+    double halo, inside;
+    status = napi_get_value_double(env, args[1], &halo);
+    if (status != napi_ok) {
+        LOGE("NapiSetIsoLevels: failed to get halo level");
+        return nullptr;
+    }
+
+    status = napi_get_value_double(env, args[2], &inside);
+    if (status != napi_ok) {
+        LOGE("NapiSetIsoLevels: failed to get inside level");
+        return nullptr;
+    }
+
+    bool applied = false;
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        applied = instance->eglCore_->SetIsoLevels((float)halo, (float)inside);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, applied, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiSetEdgeAntialiasing(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSetEdgeAntialiasing called");
+
+    size_t argc = 2;
+    napi_value args[2] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2) {
+        LOGE("NapiSetEdgeAntialiasing: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSetEdgeAntialiasing: unwrap failed");
+        return nullptr;
+    }
+
+    bool enabled;
+    status = napi_get_value_bool(env, args[1], &enabled);
+    if (status != napi_ok) {
+        LOGE("NapiSetEdgeAntialiasing: failed to get enabled flag");
+        return nullptr;
+    }
+
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        instance->eglCore_->SetEdgeAntialiasing(enabled);
+    }
+    return nullptr;
+}
+
+napi_value PluginRender::NapiSetBlockCulling(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSetBlockCulling called");
+
+    size_t argc = 2;
+    napi_value args[2] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2) {
+        LOGE("NapiSetBlockCulling: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSetBlockCulling: unwrap failed");
+        return nullptr;
+    }
+
+    bool enabled;
+    status = napi_get_value_bool(env, args[1], &enabled);
+    if (status != napi_ok) {
+        LOGE("NapiSetBlockCulling: failed to get enabled flag");
+        return nullptr;
+    }
+
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        instance->eglCore_->SetBlockCulling(enabled);
+    }
+    return nullptr;
+}
+
+napi_value PluginRender::NapiSetAttraction(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSetAttraction called");
+
+    size_t argc = 3;
+    napi_value args[3] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 3) {
+        LOGE("NapiSetAttraction: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSetAttraction: unwrap failed");
+        return nullptr;
+    }
+
+    double strength, theta;
+    status = napi_get_value_double(env, args[1], &strength);
+    if (status != napi_ok) {
+        LOGE("NapiSetAttraction: failed to get strength");
+        return nullptr;
+    }
+
+    status = napi_get_value_double(env, args[2], &theta);
+    if (status != napi_ok) {
+        LOGE("NapiSetAttraction: failed to get theta");
+        return nullptr;
+    }
+
+    bool applied = false;
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        applied = instance->eglCore_->SetAttraction((float)strength, (float)theta);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, applied, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiSetSurfaceFormat(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSetSurfaceFormat called");
+
+    size_t argc = 4;
+    napi_value args[4] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 4) {
+        LOGE("NapiSetSurfaceFormat: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSetSurfaceFormat: unwrap failed");
+        return nullptr;
+    }
+
+    int32_t profile;
+    status = napi_get_value_int32(env, args[1], &profile);
+    if (status != napi_ok) {
+        LOGE("NapiSetSurfaceFormat: failed to get profile");
+        return nullptr;
+    }
+
+    bool srgb;
+    status = napi_get_value_bool(env, args[2], &srgb);
+    if (status != napi_ok) {
+        LOGE("NapiSetSurfaceFormat: failed to get sRGB flag");
+        return nullptr;
+    }
+
+    int32_t samples;
+    status = napi_get_value_int32(env, args[3], &samples);
+    if (status != napi_ok) {
+        LOGE("NapiSetSurfaceFormat: failed to get sample count");
+        return nullptr;
+    }
+
+    bool applied = false;
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        applied = instance->eglCore_->SetSurfaceFormat(profile, srgb, samples);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, applied, &result));
+    return result;
+}
+
+static void SetNumberProperty(napi_env env, napi_value object, const char *name, double value)
+{
+    napi_value v;
+    if (napi_create_double(env, value, &v) == napi_ok) {
+        napi_set_named_property(env, object, name, v);
+    }
+}
+
+napi_value PluginRender::NapiGetSurfaceFormat(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiGetSurfaceFormat called");
+
+    size_t argc = 1;
+    napi_value args[1] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1) {
+        LOGE("NapiGetSurfaceFormat: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiGetSurfaceFormat: unwrap failed");
+        return nullptr;
+    }
+
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (!instance || !instance->eglCore_) {
+        return nullptr;
+    }
+    EGLCore *eglCore = instance->eglCore_;
+    SurfaceFormat format = eglCore->GetSurfaceFormat();
+
+    napi_value result;
+    NAPI_CALL(env, napi_create_object(env, &result));
+    SetNumberProperty(env, result, "red", format.red);
+    SetNumberProperty(env, result, "green", format.green);
+    SetNumberProperty(env, result, "blue", format.blue);
+    SetNumberProperty(env, result, "alpha", format.alpha);
+    SetNumberProperty(env, result, "samples", format.samples);
+    SetNumberProperty(env, result, "fallbackStep", format.fallbackStep);
+    SetNumberProperty(env, result, "bytesPerFrame",
+                      (double)EstimateFrameBytes(format, eglCore->width_, eglCore->height_));
+    napi_value srgb;
+    NAPI_CALL(env, napi_get_boolean(env, format.srgb, &srgb));
+    NAPI_CALL(env, napi_set_named_property(env, result, "srgb", srgb));
+    return result;
+}
+
+napi_value PluginRender::NapiSetTimeline(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSetTimeline called");
+
+    size_t argc = 4;
+    napi_value args[4] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 4) {
+        LOGE("NapiSetTimeline: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSetTimeline: unwrap failed");
+        return nullptr;
+    }
+
+    napi_typedarray_type type;
+    size_t trackCount = 0;
+    void *handles = nullptr;
+    status = napi_get_typedarray_info(env, args[1], &type, &trackCount, &handles, nullptr, nullptr);
+    if (status != napi_ok || type != napi_uint32_array) {
+        napi_throw_type_error(env, NULL, "handles must be a Uint32Array");
+        return nullptr;
+    }
+
+    size_t keyFloats = 0;
+    void *keyframes = nullptr;
+    status = napi_get_typedarray_info(env, args[2], &type, &keyFloats, &keyframes, nullptr, nullptr);
+    if (status != napi_ok || type != napi_float32_array || keyFloats % TIMELINE_KEYFRAME_FLOATS != 0) {
+        napi_throw_type_error(env, NULL, "keyframes must be a Float32Array of 6 floats per key");
+        return nullptr;
+    }
+
+    bool loop;
+    status = napi_get_value_bool(env, args[3], &loop);
+    if (status != napi_ok) {
+        LOGE("NapiSetTimeline: failed to get loop flag");
+        return nullptr;
+    }
+
+    bool loaded = false;
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        loaded = instance->eglCore_->LoadTimeline(static_cast<const MetaballHandle *>(handles), (int32_t)trackCount,
+                                                  static_cast<const float *>(keyframes),
+                                                  (int32_t)(keyFloats / TIMELINE_KEYFRAME_FLOATS), loop);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, loaded, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiClearTimeline(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiClearTimeline called");
+
+    size_t argc = 1;
+    napi_value args[1] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 1) {
+        LOGE("NapiClearTimeline: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiClearTimeline: unwrap failed");
+        return nullptr;
+    }
+
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        instance->eglCore_->ClearTimeline();
+    }
+    return nullptr;
+}
+
+napi_value PluginRender::NapiSaveScene(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSaveScene called");
+
+    size_t argc = 2;
+    napi_value args[2] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2) {
+        LOGE("NapiSaveScene: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSaveScene: unwrap failed");
+        return nullptr;
+    }
+
+    char path[PATH_MAX] = {};
+    size_t pathLen = 0;
+    status = napi_get_value_string_utf8(env, args[1], path, sizeof(path), &pathLen);
+    if (status != napi_ok || pathLen == 0) {
+        LOGE("NapiSaveScene: failed to get path");
+        return nullptr;
+    }
+
+    bool ok = SaveSceneSnapshot(std::string(path, pathLen));
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, ok, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiLoadScene(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiLoadScene called");
+
+    size_t argc = 2;
+    napi_value args[2] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2) {
+        LOGE("NapiLoadScene: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiLoadScene: unwrap failed");
+        return nullptr;
+    }
+
+    char path[PATH_MAX] = {};
+    size_t pathLen = 0;
+    status = napi_get_value_string_utf8(env, args[1], path, sizeof(path), &pathLen);
+    if (status != napi_ok || pathLen == 0) {
+        LOGE("NapiLoadScene: failed to get path");
+        return nullptr;
+    }
+
+    bool ok = LoadSceneSnapshot(std::string(path, pathLen));
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, ok, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiSampleField(napi_env env, napi_callback_info info)
+{
+    size_t argc = 3;
+    napi_value args[3] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 3) {
+        LOGE("NapiSampleField: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSampleField: unwrap failed");
+        return nullptr;
+    }
+
+    double x, y;
+    status = napi_get_value_double(env, args[1], &x);
+    if (status != napi_ok) {
+        LOGE("NapiSampleField: failed to get x coordinate");
+        return nullptr;
+    }
+
+    status = napi_get_value_double(env, args[2], &y);
+    if (status != napi_ok) {
+        LOGE("NapiSampleField: failed to get y coordinate");
+        return nullptr;
+    }
+
+    double value = 0.0;
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        value = instance->eglCore_->SampleField((float)x, (float)y);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_create_double(env, value, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiHitTest(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value args[2] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2) {
+        LOGE("NapiHitTest: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiHitTest: unwrap failed");
+        return nullptr;
+    }
+
+    napi_typedarray_type type;
+    size_t length = 0;
+    void *data = nullptr;
+    status = napi_get_typedarray_info(env, args[1], &type, &length, &data, nullptr, nullptr);
+    if (status != napi_ok || type != napi_float32_array) {
+        napi_throw_type_error(env, NULL, "points must be a Float32Array");
+        return nullptr;
+    }
+
+    size_t pointCount = length / 2;
+    void *levels = nullptr;
+    napi_value buffer;
+    NAPI_CALL(env, napi_create_arraybuffer(env, pointCount, &levels, &buffer));
+
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_ && pointCount > 0) {
+        instance->eglCore_->HitTest(static_cast<const float *>(data), pointCount, static_cast<uint8_t *>(levels));
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_create_typedarray(env, napi_uint8_array, pointCount, buffer, 0, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiCaptureScene(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiCaptureScene called");
+
+    size_t argc = 4;
+    napi_value args[4] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 4) {
+        LOGE("NapiCaptureScene: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiCaptureScene: unwrap failed");
+        return nullptr;
+    }
+
+    int32_t width, height;
+    status = napi_get_value_int32(env, args[1], &width);
+    if (status != napi_ok) {
+        LOGE("NapiCaptureScene: failed to get width");
+        return nullptr;
+    }
+
+    status = napi_get_value_int32(env, args[2], &height);
+    if (status != napi_ok) {
+        LOGE("NapiCaptureScene: failed to get height");
+        return nullptr;
+    }
+
+    napi_valuetype valuetype;
+    status = napi_typeof(env, args[3], &valuetype);
+    if (status != napi_ok || valuetype != napi_function) {
+        napi_throw_type_error(env, NULL, "callback must be a function");
+        return nullptr;
+    }
+
+    napi_value resourceName;
+    NAPI_CALL(env, napi_create_string_utf8(env, "captureScene", NAPI_AUTO_LENGTH, &resourceName));
+    napi_threadsafe_function tsfn = nullptr;
+    NAPI_CALL(env, napi_create_threadsafe_function(env, args[3], nullptr, resourceName, 0, 1, nullptr, nullptr,
+                                                   nullptr, FrameCapture::CallJs, &tsfn));
+
+    bool accepted = false;
+    std::string id("A");
+    PluginRender *instance = PluginRender::GetInstance(id);
+    if (instance && instance->eglCore_) {
+        accepted = instance->eglCore_->CaptureScene(width, height, tsfn);
+    }
+    if (!accepted) {
+        napi_release_threadsafe_function(tsfn, napi_tsfn_release);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, accepted, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiSubscribeEvents(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiSubscribeEvents called");
+
+    size_t argc = 3;
+    napi_value args[3] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 3) {
+        LOGE("NapiSubscribeEvents: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiSubscribeEvents: unwrap failed");
+        return nullptr;
+    }
+
+    uint32_t mask;
+    status = napi_get_value_uint32(env, args[1], &mask);
+    if (status != napi_ok) {
+        LOGE("NapiSubscribeEvents: failed to get event mask");
+        return nullptr;
+    }
+
+    napi_valuetype valuetype;
+    status = napi_typeof(env, args[2], &valuetype);
+    if (status != napi_ok || valuetype != napi_function) {
+        napi_throw_type_error(env, NULL, "callback must be a function");
+        return nullptr;
+    }
+
+    napi_value resourceName;
+    NAPI_CALL(env, napi_create_string_utf8(env, "renderEvents", NAPI_AUTO_LENGTH, &resourceName));
+    napi_threadsafe_function tsfn = nullptr;
+    NAPI_CALL(env, napi_create_threadsafe_function(env, args[2], nullptr, resourceName, 0, 1, nullptr, nullptr,
+                                                   nullptr, EventChannel::CallJs, &tsfn));
+
+    uint32_t subscription = g_renderEvents.Subscribe(mask, tsfn);
+    if (subscription == 0) {
+        napi_release_threadsafe_function(tsfn, napi_tsfn_release);
+    }
+
+    napi_value result;
+    NAPI_CALL(env, napi_create_uint32(env, subscription, &result));
+    return result;
+}
+
+napi_value PluginRender::NapiUnsubscribeEvents(napi_env env, napi_callback_info info)
+{
+    LOGD("NapiUnsubscribeEvents called");
+
+    size_t argc = 2;
+    napi_value args[2] = {nullptr};
+
+    napi_status status = napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (status != napi_ok || argc < 2) {
+        LOGE("NapiUnsubscribeEvents: Wrong argument count");
+        return nullptr;
+    }
+
+    napi_value exportInstance = args[0];
+    OH_NativeXComponent *nativeXComponent = nullptr;
+
+    status = napi_unwrap(env, exportInstance, reinterpret_cast<void **>(&nativeXComponent));
+    if (status != napi_ok) {
+        LOGE("NapiUnsubscribeEvents: unwrap failed");
+        return nullptr;
+    }
+
+    uint32_t subscription;
+    status = napi_get_value_uint32(env, args[1], &subscription);
+    if (status != napi_ok) {
+        LOGE("NapiUnsubscribeEvents: failed to get subscription id");
+        return nullptr;
+    }
+
+    bool removed = g_renderEvents.Unsubscribe(subscription);
+
+    napi_value result;
+    NAPI_CALL(env, napi_get_boolean(env, removed, &result));
+    return result;
+}
@@ -27,7 +27,29 @@ public:
     explicit PluginRender(std::string& id);
     static PluginRender* GetInstance(std::string& id);
     static napi_value NapiAddMetaball(napi_env env, napi_callback_info info);
+    static napi_value NapiRemoveMetaball(napi_env env, napi_callback_info info);
+    static napi_value NapiMoveMetaball(napi_env env, napi_callback_info info);
+    static napi_value NapiSetMetaballRadius(napi_env env, napi_callback_info info);
+    static napi_value NapiSetMetaballStrength(napi_env env, napi_callback_info info);
+    static napi_value NapiSetMetaballColor(napi_env env, napi_callback_info info);
     static napi_value NapiClearMetaballs(napi_env env, napi_callback_info info);
+    static napi_value NapiSetIncrementalField(napi_env env, napi_callback_info info);
+    static napi_value NapiSetGpuSimulation(napi_env env, napi_callback_info info);
+    static napi_value NapiSetIsoLevels(napi_env env, napi_callback_info info);
+    static napi_value NapiSetEdgeAntialiasing(napi_env env, napi_callback_info info);
+    static napi_value NapiSetBlockCulling(napi_env env, napi_callback_info info);
+    static napi_value NapiSetAttraction(napi_env env, napi_callback_info info);
+    static napi_value NapiSetSurfaceFormat(napi_env env, napi_callback_info info);
+    static napi_value NapiGetSurfaceFormat(napi_env env, napi_callback_info info);
+    static napi_value NapiSetTimeline(napi_env env, napi_callback_info info);
+    static napi_value NapiClearTimeline(napi_env env, napi_callback_info info);
+    static napi_value NapiSaveScene(napi_env env, napi_callback_info info);
+    static napi_value NapiLoadScene(napi_env env, napi_callback_info info);
+    static napi_value NapiSampleField(napi_env env, napi_callback_info info);
+    static napi_value NapiHitTest(napi_env env, napi_callback_info info);
+    static napi_value NapiCaptureScene(napi_env env, napi_callback_info info);
+    static napi_value NapiSubscribeEvents(napi_env env, napi_callback_info info);
+    static napi_value NapiUnsubscribeEvents(napi_env env, napi_callback_info info);
     static OH_NativeXComponent_Callback* GetNXComponentCallback();
     void SetNativeXComponent(OH_NativeXComponent* component);
     void OnSurfaceCreated(OH_NativeXComponent* component, void* window);
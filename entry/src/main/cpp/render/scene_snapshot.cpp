@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hilog/log.h>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include "render/metaball_scene.h"
+#include "render/scene_snapshot.h"
+#include "common/native_common.h"
+
+#define SNAPSHOT_MAGIC 0x4353424Du // "MBSC"
+#define SNAPSHOT_VERSION 3
+
+// Raw-byte snapshots are only sound for types with no pointers or custom copy logic.
+static_assert(std::is_trivially_copyable<MetaballPool>::value, "MetaballPool must be trivially copyable");
+static_assert(std::is_trivially_copyable<std::mt19937>::value, "std::mt19937 must be trivially copyable");
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    // Layout fingerprint: any change to these sizes makes old files unreadable on purpose.
+    uint32_t metaballBytes;
+    uint32_t poolBytes;
+    uint32_t rngBytes;
+    uint32_t ballCount;
+    // CRC-32 of everything after the header.
+    uint32_t payloadCrc;
+};
+
+// Payload offsets are kept 16-byte aligned so the mapped bytes can be read in place.
+#define ALIGN16(n) (((n) + 15u) & ~(size_t)15u)
+static const size_t POOL_OFFSET = ALIGN16(sizeof(SnapshotHeader));
+static const size_t RNG_OFFSET = POOL_OFFSET + ALIGN16(sizeof(MetaballPool));
+static const size_t SNAPSHOT_BYTES = RNG_OFFSET + sizeof(std::mt19937);
+
+static int64_t ElapsedMicros(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// CRC-32 (IEEE, reflected), table-driven.
+static uint32_t PayloadCrc(const uint8_t *data, size_t size)
+{
+    static uint32_t table[256];
+    static bool tableReady = [] {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int32_t bit = 0; bit < 8; bit++) {
+                c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        return true;
+    }();
+    (void)tableReady;
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// RestoreFrom trusts what it is given, so everything the rest of the scene code relies on
+// is checked here: a consistent pool, the header's ball count and sane per-ball values.
+static bool SnapshotPoolValid(const MetaballPool &pool, uint32_t ballCount)
+{
+    if (!pool.IsConsistent() || pool.Size() != ballCount) {
+        return false;
+    }
+    for (size_t i = 0; i < pool.Size(); i++) {
+        const Metaball &ball = pool[i];
+        const float values[] = {ball.x,    ball.y,    ball.prevX,  ball.prevY,
+                                ball.dirX, ball.dirY, ball.radius, ball.strength};
+        for (float value : values) {
+            if (!std::isfinite(value)) {
+                return false;
+            }
+        }
+        if (ball.radius < METABALL_MIN_RADIUS || ball.radius > METABALL_MAX_RADIUS || ball.strength < 0.0f ||
+            ball.strength > METABALL_MAX_STRENGTH) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool WriteAll(int fd, const uint8_t *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            return false;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+// After a rename the new directory entry is only durable once the directory itself is synced.
+static bool SyncParentDirectory(const std::string &path)
+{
+    size_t slash = path.find_last_of('/');
+    std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+}
+
+bool SaveSceneSnapshot(const std::string &path)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // Static so saving never allocates; NAPI calls are serialized on the JS thread.
+    alignas(16) static uint8_t buffer[SNAPSHOT_BYTES];
+    memset(buffer, 0, sizeof(buffer));
+    SnapshotHeader *header = reinterpret_cast<SnapshotHeader *>(buffer);
+    header->magic = SNAPSHOT_MAGIC;
+    header->version = SNAPSHOT_VERSION;
+    header->metaballBytes = sizeof(Metaball);
+    header->poolBytes = sizeof(MetaballPool);
+    header->rngBytes = sizeof(std::mt19937);
+    {
+        std::lock_guard<std::mutex> lock(g_metaballMutex);
+        header->ballCount = (uint32_t)g_metaballs.Size();
+        memcpy(buffer + POOL_OFFSET, &g_metaballs, sizeof(MetaballPool));
+        memcpy(buffer + RNG_OFFSET, &g_rng, sizeof(std::mt19937));
+    }
+    header->payloadCrc = PayloadCrc(buffer + POOL_OFFSET, SNAPSHOT_BYTES - POOL_OFFSET);
+
+    std::string tmpPath = path + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        LOGE("SaveSceneSnapshot: cannot open %{public}s", tmpPath.c_str());
+        return false;
+    }
+    bool ok = WriteAll(fd, buffer, SNAPSHOT_BYTES) && fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        LOGE("SaveSceneSnapshot: write failed for %{public}s", path.c_str());
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    if (!SyncParentDirectory(path)) {
+        LOGE("SaveSceneSnapshot: cannot sync the directory of %{public}s", path.c_str());
+        return false;
+    }
+
+    LOGI("Scene saved: %{public}u balls, %{public}zu bytes in %{public}lld us", header->ballCount, SNAPSHOT_BYTES,
+         (long long)ElapsedMicros(start));
+    return true;
+}
+
+bool LoadSceneSnapshot(const std::string &path)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOGE("LoadSceneSnapshot: cannot open %{public}s", path.c_str());
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != SNAPSHOT_BYTES) {
+        LOGE("LoadSceneSnapshot: unexpected size for %{public}s", path.c_str());
+        close(fd);
+        return false;
+    }
+    void *mapped = mmap(nullptr, SNAPSHOT_BYTES, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        LOGE("LoadSceneSnapshot: mmap failed");
+        return false;
+    }
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(mapped);
+    const SnapshotHeader *header = reinterpret_cast<const SnapshotHeader *>(bytes);
+    bool valid = header->magic == SNAPSHOT_MAGIC && header->version == SNAPSHOT_VERSION &&
+                 header->metaballBytes == sizeof(Metaball) && header->poolBytes == sizeof(MetaballPool) &&
+                 header->rngBytes == sizeof(std::mt19937);
+    uint32_t ballCount = header->ballCount;
+    if (!valid) {
+        munmap(mapped, SNAPSHOT_BYTES);
+        LOGE("LoadSceneSnapshot: incompatible snapshot %{public}s", path.c_str());
+        return false;
+    }
+    // Checked out of the mapping into a scratch pool, so a bad file never touches the live scene.
+    static MetaballPool restored;
+    memcpy(&restored, bytes + POOL_OFFSET, sizeof(MetaballPool));
+    valid = PayloadCrc(bytes + POOL_OFFSET, SNAPSHOT_BYTES - POOL_OFFSET) == header->payloadCrc &&
+            SnapshotPoolValid(restored, ballCount);
+    if (valid) {
+        std::lock_guard<std::mutex> lock(g_metaballMutex);
+        g_metaballs.RestoreFrom(restored);
+        memcpy(&g_rng, bytes + RNG_OFFSET, sizeof(std::mt19937));
+    }
+    munmap(mapped, SNAPSHOT_BYTES);
+
+    if (!valid) {
+        LOGE("LoadSceneSnapshot: corrupt snapshot %{public}s", path.c_str());
+        return false;
+    }
+    LOGI("Scene loaded: %{public}u balls in %{public}lld us", ballCount, (long long)ElapsedMicros(start));
+    return true;
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SCENE_SNAPSHOT_H
+#define SCENE_SNAPSHOT_H
+
+#include <string>
+
+/**
+ * Binary scene snapshots.
+ * A snapshot is a small versioned header followed by the raw bytes of
+ * g_metaballs and g_rng, so loading is a validated memcpy out of an mmap'd
+ * file rather than a parse. Loading checks a CRC of the payload, then the
+ * pool's tables and every ball in a scratch copy before touching the scene.
+ * Saving writes a temp file, fsyncs it, renames it over the target and
+ * fsyncs the directory, so a crash never leaves a half-written scene behind.
+ * Handles issued before a save stay valid after the matching load.
+ */
+bool SaveSceneSnapshot(const std::string &path);
+bool LoadSceneSnapshot(const std::string &path);
+
+#endif // SCENE_SNAPSHOT_H
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render/sim_clock.h"
+
+#define NS_PER_SECOND 1000000000.0
+
+SimClock::SimClock(float stepSeconds, int32_t maxStepsPerFrame)
+    : stepSeconds_(stepSeconds), stepNs_((int64_t)(stepSeconds * NS_PER_SECOND)),
+      maxStepsPerFrame_(maxStepsPerFrame)
+{
+}
+
+void SimClock::Reset()
+{
+    lastTimestampNs_ = -1;
+    accumulatorNs_ = 0;
+}
+
+int32_t SimClock::Advance(int64_t timestampNs)
+{
+    if (lastTimestampNs_ < 0 || timestampNs < lastTimestampNs_) {
+        // First frame, or the timestamp source restarted: start from rest.
+        lastTimestampNs_ = timestampNs;
+        accumulatorNs_ = 0;
+        return 0;
+    }
+
+    accumulatorNs_ += timestampNs - lastTimestampNs_;
+    lastTimestampNs_ = timestampNs;
+
+    int32_t steps = (int32_t)(accumulatorNs_ / stepNs_);
+    if (steps > maxStepsPerFrame_) {
+        // Drop the backlog but keep the phase, so motion resumes without a jump.
+        steps = maxStepsPerFrame_;
+        accumulatorNs_ %= stepNs_;
+    } else {
+        accumulatorNs_ -= steps * stepNs_;
+    }
+    return steps;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#include <cstdint>
+
+/**
+ * Fixed-timestep accumulator driven by VSync timestamps.
+ * Advance() turns the time since the previous frame into a whole number of
+ * simulation steps; the remainder is exposed as Alpha() so rendering can
+ * interpolate between the last two steps. Long stalls are capped at
+ * maxStepsPerFrame so a hitch never turns into a burst of catch-up work.
+ */
+class SimClock {
+public:
+    explicit SimClock(float stepSeconds = 1.0f / 120.0f, int32_t maxStepsPerFrame = 8);
+
+    void Reset();
+    // timestampNs is the VSync timestamp in nanoseconds. Returns the steps to run.
+    int32_t Advance(int64_t timestampNs);
+    float Alpha() const { return (float)(accumulatorNs_ / (double)stepNs_); }
+    float StepSeconds() const { return stepSeconds_; }
+
+private:
+    float stepSeconds_;
+    int64_t stepNs_;
+    int32_t maxStepsPerFrame_;
+    int64_t lastTimestampNs_ = -1;
+    int64_t accumulatorNs_ = 0;
+};
+
+#endif // SIM_CLOCK_H
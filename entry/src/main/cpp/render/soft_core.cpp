@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hilog/log.h>
+#include <algorithm>
+#include <cmath>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "render/soft_core.h"
+#include "common/native_common.h"
+
+#define SOFT_TILE_SIZE 32
+static_assert(SOFT_TILE_SIZE % CULL_BLOCK_SIZE == 0, "tiles must split into whole culling blocks");
+#define FENCE_TIMEOUT_MS 3000
+// Same clamp as the shader's "if(distSquared < 0.001)".
+#define MIN_DIST_SQUARED 0.001f
+
+static uint8_t EncodeChannel(float linear, bool srgb)
+{
+    float value = linear;
+    if (srgb) {
+        value = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+    }
+    return (uint8_t)std::lround(value * 255.0f);
+}
+
+// RGBA8888 in memory order, as the GLES framebuffer stores it.
+static uint32_t PackColor(float r, float g, float b, bool srgb)
+{
+    return (uint32_t)EncodeChannel(r, srgb) | ((uint32_t)EncodeChannel(g, srgb) << 8) |
+           ((uint32_t)EncodeChannel(b, srgb) << 16) | 0xFF000000u;
+}
+
+// Sums the field for `lanes` consecutive pixels starting at pixel center (px, py).
+static inline void SumField(float *sums, float px, float py, const float *bx, const float *by, const float *bw,
+                            int32_t count)
+{
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    const float offsets[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    float32x4_t x = vaddq_f32(vdupq_n_f32(px), vld1q_f32(offsets));
+    float32x4_t minD2 = vdupq_n_f32(MIN_DIST_SQUARED);
+    float32x4_t sum = vdupq_n_f32(0.0f);
+    for (int32_t i = 0; i < count; i++) {
+        float dy = by[i] - py;
+        float32x4_t dx = vsubq_f32(vdupq_n_f32(bx[i]), x);
+        float32x4_t d2 = vaddq_f32(vmulq_f32(dx, dx), vdupq_n_f32(dy * dy));
+        sum = vaddq_f32(sum, vdivq_f32(vdupq_n_f32(bw[i]), vmaxq_f32(d2, minD2)));
+    }
+    vst1q_f32(sums, sum);
+#elif defined(__AVX2__)
+    __m256 x = _mm256_add_ps(_mm256_set1_ps(px), _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256 minD2 = _mm256_set1_ps(MIN_DIST_SQUARED);
+    __m256 sum = _mm256_setzero_ps();
+    for (int32_t i = 0; i < count; i++) {
+        float dy = by[i] - py;
+        __m256 dx = _mm256_sub_ps(_mm256_set1_ps(bx[i]), x);
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_set1_ps(dy * dy));
+        sum = _mm256_add_ps(sum, _mm256_div_ps(_mm256_set1_ps(bw[i]), _mm256_max_ps(d2, minD2)));
+    }
+    _mm256_storeu_ps(sums, sum);
+#elif defined(__SSE2__)
+    __m128 x = _mm_add_ps(_mm_set1_ps(px), _mm_setr_ps(0, 1, 2, 3));
+    __m128 minD2 = _mm_set1_ps(MIN_DIST_SQUARED);
+    __m128 sum = _mm_setzero_ps();
+    for (int32_t i = 0; i < count; i++) {
+        float dy = by[i] - py;
+        __m128 dx = _mm_sub_ps(_mm_set1_ps(bx[i]), x);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_set1_ps(dy * dy));
+        sum = _mm_add_ps(sum, _mm_div_ps(_mm_set1_ps(bw[i]), _mm_max_ps(d2, minD2)));
+    }
+    _mm_storeu_ps(sums, sum);
+#else
+    float sum = 0.0f;
+    for (int32_t i = 0; i < count; i++) {
+        float dx = bx[i] - px;
+        float dy = by[i] - py;
+        float d2 = dx * dx + dy * dy;
+        sum += bw[i] / (d2 < MIN_DIST_SQUARED ? MIN_DIST_SQUARED : d2);
+    }
+    sums[0] = sum;
+#endif
+}
+
+// SumField plus the field-weighted tint sums, for scenes where some ball is not white.
+static inline void SumFieldTinted(float *sums, float *tints, float px, float py, const float *bx, const float *by,
+                                  const float *bw, const float *const *tint, int32_t count)
+{
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    const float offsets[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    float32x4_t x = vaddq_f32(vdupq_n_f32(px), vld1q_f32(offsets));
+    float32x4_t minD2 = vdupq_n_f32(MIN_DIST_SQUARED);
+    float32x4_t sum = vdupq_n_f32(0.0f);
+    float32x4_t r = sum;
+    float32x4_t g = sum;
+    float32x4_t b = sum;
+    for (int32_t i = 0; i < count; i++) {
+        float dy = by[i] - py;
+        float32x4_t dx = vsubq_f32(vdupq_n_f32(bx[i]), x);
+        float32x4_t d2 = vaddq_f32(vmulq_f32(dx, dx), vdupq_n_f32(dy * dy));
+        float32x4_t f = vdivq_f32(vdupq_n_f32(bw[i]), vmaxq_f32(d2, minD2));
+        sum = vaddq_f32(sum, f);
+        r = vaddq_f32(r, vmulq_f32(f, vdupq_n_f32(tint[0][i])));
+        g = vaddq_f32(g, vmulq_f32(f, vdupq_n_f32(tint[1][i])));
+        b = vaddq_f32(b, vmulq_f32(f, vdupq_n_f32(tint[2][i])));
+    }
+    vst1q_f32(sums, sum);
+    vst1q_f32(tints, r);
+    vst1q_f32(tints + 4, g);
+    vst1q_f32(tints + 8, b);
+#elif defined(__AVX2__)
+    __m256 x = _mm256_add_ps(_mm256_set1_ps(px), _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256 minD2 = _mm256_set1_ps(MIN_DIST_SQUARED);
+    __m256 sum = _mm256_setzero_ps();
+    __m256 r = sum;
+    __m256 g = sum;
+    __m256 b = sum;
+    for (int32_t i = 0; i < count; i++) {
+        float dy = by[i] - py;
+        __m256 dx = _mm256_sub_ps(_mm256_set1_ps(bx[i]), x);
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_set1_ps(dy * dy));
+        __m256 f = _mm256_div_ps(_mm256_set1_ps(bw[i]), _mm256_max_ps(d2, minD2));
+        sum = _mm256_add_ps(sum, f);
+        r = _mm256_add_ps(r, _mm256_mul_ps(f, _mm256_set1_ps(tint[0][i])));
+        g = _mm256_add_ps(g, _mm256_mul_ps(f, _mm256_set1_ps(tint[1][i])));
+        b = _mm256_add_ps(b, _mm256_mul_ps(f, _mm256_set1_ps(tint[2][i])));
+    }
+    _mm256_storeu_ps(sums, sum);
+    _mm256_storeu_ps(tints, r);
+    _mm256_storeu_ps(tints + 8, g);
+    _mm256_storeu_ps(tints + 16, b);
+#elif defined(__SSE2__)
+    __m128 x = _mm_add_ps(_mm_set1_ps(px), _mm_setr_ps(0, 1, 2, 3));
+    __m128 minD2 = _mm_set1_ps(MIN_DIST_SQUARED);
+    __m128 sum = _mm_setzero_ps();
+    __m128 r = sum;
+    __m128 g = sum;
+    __m128 b = sum;
+    for (int32_t i = 0; i < count; i++) {
+        float dy = by[i] - py;
+        __m128 dx = _mm_sub_ps(_mm_set1_ps(bx[i]), x);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_set1_ps(dy * dy));
+        __m128 f = _mm_div_ps(_mm_set1_ps(bw[i]), _mm_max_ps(d2, minD2));
+        sum = _mm_add_ps(sum, f);
+        r = _mm_add_ps(r, _mm_mul_ps(f, _mm_set1_ps(tint[0][i])));
+        g = _mm_add_ps(g, _mm_mul_ps(f, _mm_set1_ps(tint[1][i])));
+        b = _mm_add_ps(b, _mm_mul_ps(f, _mm_set1_ps(tint[2][i])));
+    }
+    _mm_storeu_ps(sums, sum);
+    _mm_storeu_ps(tints, r);
+    _mm_storeu_ps(tints + 4, g);
+    _mm_storeu_ps(tints + 8, b);
+#else
+    float sum = 0.0f;
+    float r = 0.0f;
+    float g = 0.0f;
+    float b = 0.0f;
+    for (int32_t i = 0; i < count; i++) {
+        float dx = bx[i] - px;
+        float dy = by[i] - py;
+        float d2 = dx * dx + dy * dy;
+        float f = bw[i] / (d2 < MIN_DIST_SQUARED ? MIN_DIST_SQUARED : d2);
+        sum += f;
+        r += f * tint[0][i];
+        g += f * tint[1][i];
+        b += f * tint[2][i];
+    }
+    sums[0] = sum;
+    tints[0] = r;
+    tints[1] = g;
+    tints[2] = b;
+#endif
+}
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define SOFT_LANES 4
+#elif defined(__AVX2__)
+#define SOFT_LANES 8
+#elif defined(__SSE2__)
+#define SOFT_LANES 4
+#else
+#define SOFT_LANES 1
+#endif
+
+SoftCore::SoftCore(int32_t threadCount, bool srgb) : pool_(threadCount)
+{
+    innerColor_ = PackColor(ISO_PALETTE[2][0], ISO_PALETTE[2][1], ISO_PALETTE[2][2], srgb);
+    outerColor_ = PackColor(ISO_PALETTE[1][0], ISO_PALETTE[1][1], ISO_PALETTE[1][2], srgb);
+    backgroundColor_ = PackColor(ISO_PALETTE[0][0], ISO_PALETTE[0][1], ISO_PALETTE[0][2], srgb);
+    for (int32_t i = 0; i < SOFT_ENCODE_LUT_SIZE; i++) {
+        encodeLut_[i] = EncodeChannel((float)i / (SOFT_ENCODE_LUT_SIZE - 1), srgb);
+    }
+    LOGI("SoftCore created with %{public}d threads, %{public}d lanes", pool_.ThreadCount(), SOFT_LANES);
+}
+
+void SoftCore::OnSurfaceCreated(void *window, int32_t w, int32_t h)
+{
+    window_ = reinterpret_cast<OHNativeWindow *>(window);
+    OnSurfaceChanged(window, w, h);
+    if (window_) {
+        OH_NativeWindow_NativeWindowHandleOpt(window_, SET_FORMAT, NATIVEBUFFER_PIXEL_FMT_RGBA_8888);
+    }
+}
+
+void SoftCore::OnSurfaceChanged(void *window, int32_t w, int32_t h)
+{
+    width_ = w;
+    height_ = h;
+    if (window_) {
+        OH_NativeWindow_NativeWindowHandleOpt(window_, SET_BUFFER_GEOMETRY, w, h);
+    }
+}
+
+void SoftCore::OnSurfaceDestroyed()
+{
+    window_ = nullptr;
+}
+
+void SoftCore::RenderFrame(const float *positions, const float *weights, const uint32_t *colors, int32_t count)
+{
+    if (!window_) {
+        return;
+    }
+
+    OHNativeWindowBuffer *buffer = nullptr;
+    int fenceFd = -1;
+    if (OH_NativeWindow_NativeWindowRequestBuffer(window_, &buffer, &fenceFd) != 0 || !buffer) {
+        LOGE("SoftCore: RequestBuffer failed");
+        return;
+    }
+
+    // The compositor may still be reading this buffer; wait for its release fence.
+    if (fenceFd >= 0) {
+        struct pollfd pfd = {fenceFd, POLLIN, 0};
+        poll(&pfd, 1, FENCE_TIMEOUT_MS);
+        close(fenceFd);
+    }
+
+    BufferHandle *handle = OH_NativeWindow_GetBufferHandleFromNative(buffer);
+    void *mapped = mmap(handle->virAddr, handle->size, PROT_READ | PROT_WRITE, MAP_SHARED, handle->fd, 0);
+    if (mapped == MAP_FAILED) {
+        LOGE("SoftCore: mmap failed");
+        OH_NativeWindow_NativeWindowAbortBuffer(window_, buffer);
+        return;
+    }
+
+    int32_t w = handle->width < width_ ? handle->width : width_;
+    int32_t h = handle->height < height_ ? handle->height : height_;
+    RenderToBuffer(positions, weights, colors, count, reinterpret_cast<uint32_t *>(mapped), w, h, handle->stride);
+
+    Region region{nullptr, 0};
+    OH_NativeWindow_NativeWindowFlushBuffer(window_, buffer, -1, region);
+    munmap(mapped, handle->size);
+}
+
+void SoftCore::RenderToBuffer(const float *positions, const float *weights, const uint32_t *colors, int32_t count,
+                              uint32_t *pixels, int32_t w, int32_t h, int32_t strideBytes)
+{
+    if (count > MAX_METABALLS) {
+        count = MAX_METABALLS;
+    }
+    tinted_ = false;
+    for (int32_t i = 0; i < count; i++) {
+        ballX_[i] = positions[2 * i];
+        ballY_[i] = positions[2 * i + 1];
+        ballW_[i] = weights[i];
+        tinted_ = tinted_ || colors[i] != METABALL_WHITE;
+    }
+    if (tinted_) {
+        for (int32_t i = 0; i < count; i++) {
+            tintR_[i] = (float)(colors[i] & 0xFFu) / 255.0f;
+            tintG_[i] = (float)((colors[i] >> 8) & 0xFFu) / 255.0f;
+            tintB_[i] = (float)((colors[i] >> 16) & 0xFFu) / 255.0f;
+        }
+    }
+
+    if (blockCulling_) {
+        culler_.Classify(positions, weights, count, levels_, w, h);
+    }
+
+    uint32_t tilesX = (uint32_t)(w + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    uint32_t tilesY = (uint32_t)(h + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    pool_.ParallelFor(tilesX * tilesY, [=](uint32_t tile) {
+        ShadeTile(tile, pixels, w, h, strideBytes, count);
+    });
+}
+
+void SoftCore::ShadeTile(uint32_t tile, uint32_t *pixels, int32_t w, int32_t h, int32_t strideBytes, int32_t count)
+{
+    int32_t tilesX = (w + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+    int32_t x0 = (int32_t)(tile % tilesX) * SOFT_TILE_SIZE;
+    int32_t y0 = (int32_t)(tile / tilesX) * SOFT_TILE_SIZE;
+    int32_t x1 = x0 + SOFT_TILE_SIZE < w ? x0 + SOFT_TILE_SIZE : w;
+    int32_t y1 = y0 + SOFT_TILE_SIZE < h ? y0 + SOFT_TILE_SIZE : h;
+    if (!blockCulling_) {
+        ShadeBlock(x0, y0, x1, y1, pixels, strideBytes, count);
+        return;
+    }
+
+    const uint32_t blockColors[3] = {backgroundColor_, outerColor_, innerColor_};
+    for (int32_t by = y0; by < y1; by += CULL_BLOCK_SIZE) {
+        int32_t byEnd = by + CULL_BLOCK_SIZE < y1 ? by + CULL_BLOCK_SIZE : y1;
+        for (int32_t bx = x0; bx < x1; bx += CULL_BLOCK_SIZE) {
+            int32_t bxEnd = bx + CULL_BLOCK_SIZE < x1 ? bx + CULL_BLOCK_SIZE : x1;
+            BlockClass blockClass = culler_.At(bx / CULL_BLOCK_SIZE, by / CULL_BLOCK_SIZE);
+            // A tint varies inside a band, so only outside blocks can be filled flat then.
+            if (blockClass == BLOCK_EDGE || (tinted_ && blockClass != BLOCK_OUTSIDE)) {
+                ShadeBlock(bx, by, bxEnd, byEnd, pixels, strideBytes, count);
+            } else {
+                FillBlock(bx, by, bxEnd, byEnd, pixels, strideBytes, blockColors[blockClass]);
+            }
+        }
+    }
+}
+
+void SoftCore::ShadeBlock(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t *pixels, int32_t strideBytes,
+                          int32_t count)
+{
+    if (tinted_) {
+        ShadeBlockTinted(x0, y0, x1, y1, pixels, strideBytes, count);
+        return;
+    }
+    float halo = levels_.halo;
+    float inside = levels_.inside;
+    float sums[SOFT_LANES];
+    for (int32_t y = y0; y < y1; y++) {
+        uint32_t *row = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(pixels) + (size_t)y * strideBytes);
+        // Memory row 0 is the top of the window, which is where the shader's flipped y starts too.
+        float py = (float)y + 0.5f;
+        for (int32_t x = x0; x < x1; x += SOFT_LANES) {
+            SumField(sums, (float)x + 0.5f, py, ballX_, ballY_, ballW_, count);
+            int32_t lanes = x1 - x < SOFT_LANES ? x1 - x : SOFT_LANES;
+            for (int32_t i = 0; i < lanes; i++) {
+                float sum = sums[i];
+                row[x + i] = sum >= inside ? innerColor_ : (sum >= halo ? outerColor_ : backgroundColor_);
+            }
+        }
+    }
+}
+
+void SoftCore::ShadeBlockTinted(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t *pixels,
+                                int32_t strideBytes, int32_t count)
+{
+    const float *tint[3] = {tintR_, tintG_, tintB_};
+    const float lutScale = (float)(SOFT_ENCODE_LUT_SIZE - 1);
+    float halo = levels_.halo;
+    float inside = levels_.inside;
+    float sums[SOFT_LANES];
+    // Per channel, SOFT_LANES consecutive pixels.
+    float tints[3 * SOFT_LANES];
+    for (int32_t y = y0; y < y1; y++) {
+        uint32_t *row = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(pixels) + (size_t)y * strideBytes);
+        float py = (float)y + 0.5f;
+        for (int32_t x = x0; x < x1; x += SOFT_LANES) {
+            SumFieldTinted(sums, tints, (float)x + 0.5f, py, ballX_, ballY_, ballW_, tint, count);
+            int32_t lanes = x1 - x < SOFT_LANES ? x1 - x : SOFT_LANES;
+            for (int32_t i = 0; i < lanes; i++) {
+                float sum = sums[i];
+                int32_t band = sum >= inside ? BLOCK_INSIDE : (sum >= halo ? BLOCK_HALO : BLOCK_OUTSIDE);
+                if (band == BLOCK_OUTSIDE) {
+                    row[x + i] = backgroundColor_;
+                    continue;
+                }
+                // The tint is the field-weighted mean of the balls' colors, so it stays within [0, 1].
+                float scale = lutScale / sum;
+                uint32_t color = 0xFF000000u;
+                for (int32_t c = 0; c < 3; c++) {
+                    int32_t index = (int32_t)(ISO_PALETTE[band][c] * tints[c * SOFT_LANES + i] * scale + 0.5f);
+                    color |= (uint32_t)encodeLut_[std::min(index, SOFT_ENCODE_LUT_SIZE - 1)] << (8 * c);
+                }
+                row[x + i] = color;
+            }
+        }
+    }
+}
+
+void SoftCore::FillBlock(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t *pixels, int32_t strideBytes,
+                         uint32_t color)
+{
+    for (int32_t y = y0; y < y1; y++) {
+        uint32_t *row = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(pixels) + (size_t)y * strideBytes);
+        std::fill(row + x0, row + x1, color);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SOFT_CORE_H
+#define SOFT_CORE_H
+
+#include <cstdint>
+#include <native_window/external_window.h>
+#include "render/block_culler.h"
+#include "render/iso_levels.h"
+#include "render/metaball_pool.h"
+#include "render/thread_pool.h"
+
+#define SOFT_ENCODE_LUT_SIZE 4096
+
+/**
+ * CPU renderer for the metaball field, used when no GLES 3 driver is available.
+ * Produces the same image as g_fragmentShader: the frame is cut into tiles that
+ * run on a work-stealing ThreadPool, and each tile sums the field with NEON,
+ * AVX2 or SSE2 depending on the target. Output goes either to the XComponent
+ * native window or to a caller-owned RGBA8888 buffer.
+ */
+class SoftCore {
+public:
+    // srgb mirrors the EGL surface colorspace, so the palette is encoded the same way.
+    explicit SoftCore(int32_t threadCount = 0, bool srgb = true);
+    void OnSurfaceCreated(void *window, int32_t w, int32_t h);
+    void OnSurfaceChanged(void *window, int32_t w, int32_t h);
+    void OnSurfaceDestroyed();
+    // weights and colors are per ball, laid out like g_metaballWeights and g_metaballColors.
+    void RenderFrame(const float *positions, const float *weights, const uint32_t *colors, int32_t count);
+    void RenderToBuffer(const float *positions, const float *weights, const uint32_t *colors, int32_t count,
+                        uint32_t *pixels, int32_t w, int32_t h, int32_t strideBytes);
+    int32_t ThreadCount() const { return pool_.ThreadCount(); }
+    // Hard steps at the isolevels; the CPU path has no screen-space derivatives to blend with.
+    void SetIsoLevels(const IsoLevels &levels) { levels_ = levels; }
+    // Fills blocks that lie wholly inside one band without running the per-pixel loop.
+    void SetBlockCulling(bool enabled) { blockCulling_ = enabled; }
+    float SkippedFraction() const { return blockCulling_ ? culler_.SkippedFraction() : 0.0f; }
+
+private:
+    void ShadeTile(uint32_t tile, uint32_t *pixels, int32_t w, int32_t h, int32_t strideBytes, int32_t count);
+    void ShadeBlock(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t *pixels, int32_t strideBytes,
+                    int32_t count);
+    void ShadeBlockTinted(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t *pixels, int32_t strideBytes,
+                          int32_t count);
+    void FillBlock(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t *pixels, int32_t strideBytes,
+                   uint32_t color);
+
+    ThreadPool pool_;
+    OHNativeWindow *window_ = nullptr;
+    int32_t width_ = 0;
+    int32_t height_ = 0;
+    uint32_t innerColor_;
+    uint32_t outerColor_;
+    uint32_t backgroundColor_;
+    // Linear [0, 1] to the surface's 8-bit encoding, for colors only known per pixel.
+    uint8_t encodeLut_[SOFT_ENCODE_LUT_SIZE];
+    IsoLevels levels_;
+    bool blockCulling_ = true;
+    BlockCuller culler_;
+    // SoA copy of the frame's balls, read by every tile.
+    float ballX_[MAX_METABALLS];
+    float ballY_[MAX_METABALLS];
+    float ballW_[MAX_METABALLS];
+    // Tint channels in [0, 1]; only filled when tinted_ is set.
+    float tintR_[MAX_METABALLS];
+    float tintG_[MAX_METABALLS];
+    float tintB_[MAX_METABALLS];
+    bool tinted_ = false;
+};
+
+#endif // SOFT_CORE_H
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hilog/log.h>
+#include <vector>
+#include <native_window/external_window.h>
+#include "render/surface_format.h"
+#include "common/native_common.h"
+
+#define SURFACE_SCORE_BASE 1000
+// Per bit of alpha the profile does not use.
+#define SURFACE_ALPHA_COST 4
+// Per sample beyond the requested count.
+#define SURFACE_SAMPLE_COST 16
+// Per depth or stencil bit; nothing here tests either.
+#define SURFACE_DEPTH_COST 1
+#define SURFACE_SLOW_COST 500
+// The request, no MSAA, two widenings; the last-resort step comes after these.
+#define SURFACE_MAX_CHAIN 4
+
+// Red, green, blue and alpha bits per profile.
+static const int32_t PROFILE_BITS[SURFACE_PROFILE_COUNT][4] = {
+    {8, 8, 8, 8},
+    {8, 8, 8, 0},
+    {5, 6, 5, 0},
+};
+
+const char *SurfaceProfileName(SurfaceProfile profile)
+{
+    switch (profile) {
+        case SURFACE_RGBA8888:
+            return "rgba8888";
+        case SURFACE_RGB888:
+            return "rgb888";
+        case SURFACE_RGB565:
+            return "rgb565";
+        default:
+            return "unknown";
+    }
+}
+
+int32_t ScoreSurfaceConfig(const SurfaceConfigInfo &info, const SurfaceRequest &request)
+{
+    const int32_t *bits = PROFILE_BITS[request.profile];
+    // Exact RGB only: a deeper config would spend the bandwidth the profile is meant to save.
+    if (info.red != bits[0] || info.green != bits[1] || info.blue != bits[2]) {
+        return -1;
+    }
+    if (info.alpha < bits[3] || info.samples < request.samples) {
+        return -1;
+    }
+    int32_t score = SURFACE_SCORE_BASE;
+    score -= (info.alpha - bits[3]) * SURFACE_ALPHA_COST;
+    score -= (info.samples - request.samples) * SURFACE_SAMPLE_COST;
+    score -= (info.depth + info.stencil) * SURFACE_DEPTH_COST;
+    if (info.slow) {
+        score -= SURFACE_SLOW_COST;
+    }
+    return score;
+}
+
+// MSAA goes first: the field shader already antialiases its isolines analytically.
+static int32_t BuildFallbackChain(const SurfaceRequest &request, SurfaceRequest *chain)
+{
+    int32_t length = 0;
+    chain[length++] = request;
+    SurfaceRequest relaxed = request;
+    if (relaxed.samples > 0) {
+        relaxed.samples = 0;
+        chain[length++] = relaxed;
+    }
+    while (relaxed.profile != SURFACE_RGBA8888) {
+        relaxed.profile = (SurfaceProfile)(relaxed.profile - 1);
+        chain[length++] = relaxed;
+    }
+    return length;
+}
+
+int32_t PickSurfaceConfig(const SurfaceConfigInfo *infos, int32_t count, const SurfaceRequest &request,
+                          int32_t &fallbackStep)
+{
+    if (count <= 0) {
+        return -1;
+    }
+    SurfaceRequest chain[SURFACE_MAX_CHAIN];
+    int32_t length = BuildFallbackChain(request, chain);
+    for (int32_t step = 0; step < length; step++) {
+        int32_t best = -1;
+        int32_t bestScore = -1;
+        for (int32_t i = 0; i < count; i++) {
+            int32_t score = ScoreSurfaceConfig(infos[i], chain[step]);
+            if (score > bestScore) {
+                best = i;
+                bestScore = score;
+            }
+        }
+        if (best >= 0) {
+            fallbackStep = step;
+            return best;
+        }
+    }
+    // Nothing fits any profile: take what the driver ranks first, as before the chooser existed.
+    fallbackStep = length;
+    return 0;
+}
+
+EGLConfig ChooseSurfaceConfig(EGLDisplay display, EGLint surfaceType, const SurfaceRequest &request,
+                              SurfaceFormat &format)
+{
+    EGLint attribList[] = {EGL_SURFACE_TYPE, surfaceType, EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT, EGL_NONE};
+    EGLint count = 0;
+    if (!eglChooseConfig(display, attribList, nullptr, 0, &count) || count <= 0) {
+        LOGE("ChooseSurfaceConfig: no ES3 configs");
+        return nullptr;
+    }
+    std::vector<EGLConfig> configs(count);
+    if (!eglChooseConfig(display, attribList, configs.data(), count, &count) || count <= 0) {
+        LOGE("eglChooseConfig ERROR");
+        return nullptr;
+    }
+
+    std::vector<SurfaceConfigInfo> infos(count);
+    for (EGLint i = 0; i < count; i++) {
+        SurfaceConfigInfo &info = infos[i];
+        EGLint caveat = EGL_NONE;
+        eglGetConfigAttrib(display, configs[i], EGL_RED_SIZE, &info.red);
+        eglGetConfigAttrib(display, configs[i], EGL_GREEN_SIZE, &info.green);
+        eglGetConfigAttrib(display, configs[i], EGL_BLUE_SIZE, &info.blue);
+        eglGetConfigAttrib(display, configs[i], EGL_ALPHA_SIZE, &info.alpha);
+        eglGetConfigAttrib(display, configs[i], EGL_DEPTH_SIZE, &info.depth);
+        eglGetConfigAttrib(display, configs[i], EGL_STENCIL_SIZE, &info.stencil);
+        eglGetConfigAttrib(display, configs[i], EGL_SAMPLES, &info.samples);
+        eglGetConfigAttrib(display, configs[i], EGL_CONFIG_CAVEAT, &caveat);
+        info.slow = caveat == EGL_SLOW_CONFIG;
+    }
+
+    int32_t step = 0;
+    int32_t best = PickSurfaceConfig(infos.data(), count, request, step);
+    const SurfaceConfigInfo &chosen = infos[best];
+    format.red = chosen.red;
+    format.green = chosen.green;
+    format.blue = chosen.blue;
+    format.alpha = chosen.alpha;
+    format.samples = chosen.samples;
+    format.fallbackStep = step;
+    if (step > 0) {
+        LOGW("ChooseSurfaceConfig: %{public}s x%{public}d unavailable, fell back %{public}d step(s)",
+             SurfaceProfileName(request.profile), request.samples, step);
+    }
+    return configs[best];
+}
+
+int32_t SurfaceNativeFormat(const SurfaceFormat &format)
+{
+    for (int32_t profile = 0; profile < SURFACE_PROFILE_COUNT; profile++) {
+        const int32_t *bits = PROFILE_BITS[profile];
+        if (format.red == bits[0] && format.green == bits[1] && format.blue == bits[2] && format.alpha == bits[3]) {
+            static const int32_t nativeFormats[SURFACE_PROFILE_COUNT] = {
+                NATIVEBUFFER_PIXEL_FMT_RGBA_8888, NATIVEBUFFER_PIXEL_FMT_RGBX_8888, NATIVEBUFFER_PIXEL_FMT_RGB_565};
+            return nativeFormats[profile];
+        }
+    }
+    return -1;
+}
+
+int64_t EstimateFrameBytes(const SurfaceFormat &format, int32_t width, int32_t height)
+{
+    int64_t plane = (int64_t)width * height * format.BytesPerPixel();
+    if (format.samples > 1) {
+        // Upper bound: a tiler resolves on chip and never writes the multisampled plane out.
+        return plane * format.samples + 2 * plane;
+    }
+    return 2 * plane;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SURFACE_FORMAT_H
+#define SURFACE_FORMAT_H
+
+#include <cstdint>
+#include <EGL/egl.h>
+
+// Color layouts the window surface can be asked for, narrowest last.
+enum SurfaceProfile : int32_t {
+    SURFACE_RGBA8888 = 0,
+    SURFACE_RGB888 = 1,
+    SURFACE_RGB565 = 2,
+};
+#define SURFACE_PROFILE_COUNT 3
+#define SURFACE_MAX_SAMPLES 16
+
+// What setSurfaceFormat asked for. Opaque RGB888 by default: the field output never needs alpha.
+struct SurfaceRequest {
+    SurfaceProfile profile = SURFACE_RGB888;
+    bool srgb = true;
+    int32_t samples = 0;
+
+    bool Valid() const
+    {
+        return profile >= SURFACE_RGBA8888 && profile < SURFACE_PROFILE_COUNT && samples >= 0 &&
+               samples <= SURFACE_MAX_SAMPLES;
+    }
+};
+
+// The attributes of one EGLConfig the scorer looks at.
+struct SurfaceConfigInfo {
+    int32_t red;
+    int32_t green;
+    int32_t blue;
+    int32_t alpha;
+    int32_t depth;
+    int32_t stencil;
+    int32_t samples;
+    // EGL_SLOW_CONFIG caveat.
+    bool slow;
+};
+
+// The format the window surface actually got.
+struct SurfaceFormat {
+    int32_t red = 8;
+    int32_t green = 8;
+    int32_t blue = 8;
+    int32_t alpha = 8;
+    int32_t samples = 0;
+    // True if the surface encodes sRGB on write; otherwise the field shaders encode it themselves.
+    bool srgb = true;
+    // Index into the fallback chain; 0 means the request was met as given.
+    int32_t fallbackStep = 0;
+
+    // Storage per pixel: 24-bit layouts are padded to 32 bits by the GPU and the compositor alike.
+    int32_t BytesPerPixel() const { return red + green + blue + alpha > 16 ? 4 : 2; }
+};
+
+/**
+ * Scored EGL config selection.
+ * Every ES3 config of the wanted surface type is scored against the request:
+ * the RGB sizes must match the profile exactly, the sample count must be at
+ * least the requested one, and unused alpha, depth, stencil and extra samples
+ * cost points, since each is memory written every frame. If nothing matches,
+ * the request is relaxed along a fixed chain (drop MSAA, then widen
+ * 565 -> 888 -> 8888) and, as a last resort, the first ES3 config is taken.
+ */
+const char *SurfaceProfileName(SurfaceProfile profile);
+// Higher is better; -1 if the config cannot serve the request.
+int32_t ScoreSurfaceConfig(const SurfaceConfigInfo &info, const SurfaceRequest &request);
+// Index of the best config along the fallback chain, or -1 if count is 0.
+int32_t PickSurfaceConfig(const SurfaceConfigInfo *infos, int32_t count, const SurfaceRequest &request,
+                          int32_t &fallbackStep);
+// surfaceType is EGL_WINDOW_BIT or EGL_PBUFFER_BIT. Fills every field of format except srgb.
+EGLConfig ChooseSurfaceConfig(EGLDisplay display, EGLint surfaceType, const SurfaceRequest &request,
+                              SurfaceFormat &format);
+// NATIVEBUFFER_PIXEL_FMT_* the window buffers should use for this format; -1 if it is none of the profiles.
+int32_t SurfaceNativeFormat(const SurfaceFormat &format);
+// Color memory traffic for one frame: the render target, the MSAA resolve and the compositor's read.
+int64_t EstimateFrameBytes(const SurfaceFormat &format, int32_t width, int32_t height);
+
+#endif // SURFACE_FORMAT_H
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include "render/thread_pool.h"
+
+static inline uint64_t PackRange(uint32_t begin, uint32_t end)
+{
+    return ((uint64_t)end << 32) | begin;
+}
+
+static inline uint32_t RangeBegin(uint64_t bounds)
+{
+    return (uint32_t)bounds;
+}
+
+static inline uint32_t RangeEnd(uint64_t bounds)
+{
+    return (uint32_t)(bounds >> 32);
+}
+
+ThreadPool::ThreadPool(int32_t threadCount)
+{
+    if (threadCount <= 0) {
+        threadCount = std::max(1, (int32_t)std::thread::hardware_concurrency());
+    }
+    ranges_ = std::vector<TaskRange>(threadCount);
+    for (int32_t i = 1; i < threadCount; i++) {
+        threads_.emplace_back(&ThreadPool::WorkerMain, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::ParallelFor(uint32_t count, const std::function<void(uint32_t)> &task)
+{
+    if (count == 0) {
+        return;
+    }
+    uint32_t workers = (uint32_t)ranges_.size();
+    if (workers == 1 || count == 1) {
+        for (uint32_t i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    for (uint32_t w = 0; w < workers; w++) {
+        uint32_t begin = (uint32_t)((uint64_t)count * w / workers);
+        uint32_t end = (uint32_t)((uint64_t)count * (w + 1) / workers);
+        ranges_[w].bounds.store(PackRange(begin, end), std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        busyWorkers_ = (int32_t)workers - 1;
+        jobId_++;
+    }
+    wake_.notify_all();
+
+    RunTasks(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return busyWorkers_ == 0; });
+    task_ = nullptr;
+}
+
+void ThreadPool::WorkerMain(int32_t worker)
+{
+    uint64_t seenJob = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this, seenJob] { return stop_ || jobId_ != seenJob; });
+            if (stop_) {
+                return;
+            }
+            seenJob = jobId_;
+        }
+
+        RunTasks(worker);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--busyWorkers_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+void ThreadPool::RunTasks(int32_t worker)
+{
+    const std::function<void(uint32_t)> &task = *task_;
+    uint32_t index;
+    for (;;) {
+        while (PopFront(worker, index)) {
+            task(index);
+        }
+        if (!Steal(worker, index)) {
+            return;
+        }
+        task(index);
+    }
+}
+
+bool ThreadPool::PopFront(int32_t worker, uint32_t &index)
+{
+    std::atomic<uint64_t> &bounds = ranges_[worker].bounds;
+    uint64_t current = bounds.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t begin = RangeBegin(current);
+        uint32_t end = RangeEnd(current);
+        if (begin >= end) {
+            return false;
+        }
+        if (bounds.compare_exchange_weak(current, PackRange(begin + 1, end), std::memory_order_acq_rel)) {
+            index = begin;
+            return true;
+        }
+    }
+}
+
+bool ThreadPool::Steal(int32_t thief, uint32_t &index)
+{
+    int32_t workers = (int32_t)ranges_.size();
+    for (;;) {
+        // Pick the victim with the most work left; stop once everyone is dry.
+        int32_t victim = -1;
+        uint32_t most = 0;
+        uint64_t victimBounds = 0;
+        for (int32_t i = 1; i < workers; i++) {
+            int32_t candidate = (thief + i) % workers;
+            uint64_t bounds = ranges_[candidate].bounds.load(std::memory_order_acquire);
+            uint32_t left = RangeEnd(bounds) > RangeBegin(bounds) ? RangeEnd(bounds) - RangeBegin(bounds) : 0;
+            if (left > most) {
+                most = left;
+                victim = candidate;
+                victimBounds = bounds;
+            }
+        }
+        if (victim < 0) {
+            return false;
+        }
+
+        // Take the back half (rounded up) so a single leftover task can be stolen too.
+        uint32_t begin = RangeBegin(victimBounds);
+        uint32_t end = RangeEnd(victimBounds);
+        uint32_t mid = end - (most + 1) / 2;
+        if (!ranges_[victim].bounds.compare_exchange_strong(victimBounds, PackRange(begin, mid),
+                                                            std::memory_order_acq_rel)) {
+            continue;
+        }
+        ranges_[thief].bounds.store(PackRange(mid + 1, end), std::memory_order_release);
+        index = mid;
+        return true;
+    }
+}
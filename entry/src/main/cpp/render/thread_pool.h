@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fork-join pool for data-parallel frame work.
+ * ParallelFor splits [0, count) evenly across workers up front; a worker that
+ * runs dry steals half of the largest remaining range from a peer, so uneven
+ * tiles (dense blob vs. empty background) still finish together. The calling
+ * thread takes part as worker 0.
+ */
+class ThreadPool {
+public:
+    // threadCount <= 0 picks hardware_concurrency().
+    explicit ThreadPool(int32_t threadCount = 0);
+    ~ThreadPool();
+
+    int32_t ThreadCount() const { return (int32_t)ranges_.size(); }
+    void ParallelFor(uint32_t count, const std::function<void(uint32_t)> &task);
+
+private:
+    // Packed [begin, end) so owner pops and thief splits are single CAS operations.
+    struct alignas(64) TaskRange {
+        std::atomic<uint64_t> bounds{0};
+    };
+
+    void WorkerMain(int32_t worker);
+    void RunTasks(int32_t worker);
+    bool PopFront(int32_t worker, uint32_t &index);
+    bool Steal(int32_t thief, uint32_t &index);
+
+    std::vector<TaskRange> ranges_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(uint32_t)> *task_ = nullptr;
+    uint64_t jobId_ = 0;
+    int32_t busyWorkers_ = 0;
+    bool stop_ = false;
+};
+
+#endif // THREAD_POOL_H
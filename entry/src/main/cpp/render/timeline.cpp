@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hilog/log.h>
+#include <algorithm>
+#include <cmath>
+#include "render/metaball_scene.h"
+#include "render/timeline.h"
+#include "common/native_common.h"
+
+#define NS_PER_SECOND 1e9
+
+bool Timeline::Load(const MetaballHandle *handles, int32_t trackCount, const float *keyframes, int32_t keyCount,
+                    bool loop)
+{
+    if (trackCount <= 0 || keyCount <= 0 || keyCount > TIMELINE_MAX_KEYFRAMES) {
+        LOGE("Timeline: %{public}d tracks, %{public}d keyframes rejected", trackCount, keyCount);
+        return false;
+    }
+
+    // Counting pass: keys may arrive interleaved across tracks but stay in time order within one.
+    std::vector<int32_t> start(trackCount + 1, 0);
+    for (int32_t k = 0; k < keyCount; k++) {
+        const float *key = &keyframes[k * TIMELINE_KEYFRAME_FLOATS];
+        // Range-check before the cast: converting NaN or an out-of-range float to int is undefined.
+        bool trackInRange = key[0] >= 0.0f && key[0] < (float)trackCount;
+        int32_t track = trackInRange ? (int32_t)key[0] : -1;
+        // Every test below also rejects NaN. Radii get the same range setMetaballRadius enforces.
+        if (!trackInRange || key[0] != (float)track || !std::isfinite(key[1]) || key[1] < 0.0f ||
+            !std::isfinite(key[2]) || !std::isfinite(key[3]) || !std::isfinite(key[4]) ||
+            key[4] < METABALL_MIN_RADIUS || key[4] > METABALL_MAX_RADIUS ||
+            !(key[5] >= EASE_LINEAR && key[5] <= EASE_STEP)) {
+            LOGE("Timeline: keyframe %{public}d is malformed", k);
+            return false;
+        }
+        start[track + 1]++;
+    }
+    for (int32_t t = 0; t < trackCount; t++) {
+        if (start[t + 1] == 0) {
+            LOGE("Timeline: track %{public}d has no keyframes", t);
+            return false;
+        }
+        start[t + 1] += start[t];
+    }
+
+    std::vector<int32_t> fill(start.begin(), start.end() - 1);
+    std::vector<float> time(keyCount), x(keyCount), y(keyCount), radius(keyCount), easing(keyCount);
+    float duration = 0.0f;
+    for (int32_t k = 0; k < keyCount; k++) {
+        const float *key = &keyframes[k * TIMELINE_KEYFRAME_FLOATS];
+        int32_t track = (int32_t)key[0];
+        int32_t slot = fill[track]++;
+        if (slot > start[track] && key[1] < time[slot - 1]) {
+            LOGE("Timeline: track %{public}d keyframes are out of order", track);
+            return false;
+        }
+        time[slot] = key[1];
+        x[slot] = key[2];
+        y[slot] = key[3];
+        radius[slot] = key[4];
+        easing[slot] = std::floor(key[5]);
+        duration = std::max(duration, key[1]);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    trackCount_ = trackCount;
+    handles_.assign(handles, handles + trackCount);
+    trackStart_.swap(start);
+    keyTime_.swap(time);
+    keyX_.swap(x);
+    keyY_.swap(y);
+    keyRadius_.swap(radius);
+    keyEasing_.swap(easing);
+    cursor_.assign(trackCount, 0);
+    for (auto *v : {&segStart_, &segInvSpan_, &segEasing_, &segX0_, &segDx_, &segY0_, &segDy_, &segR0_, &segDr_,
+                    &outX_, &outY_, &outRadius_}) {
+        v->resize(trackCount);
+    }
+    loop_ = loop;
+    duration_ = duration;
+    startNs_ = -1;
+    lastSeconds_ = 0.0f;
+    active_ = true;
+    LOGI("Timeline loaded: %{public}d tracks, %{public}d keyframes, %{public}f s", trackCount, keyCount, duration);
+    return true;
+}
+
+void Timeline::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_ = false;
+}
+
+void Timeline::Apply(int64_t timestampNs, MetaballPool &pool)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!active_) {
+        return;
+    }
+    if (startNs_ < 0) {
+        startNs_ = timestampNs;
+    }
+
+    float seconds = (float)((double)(timestampNs - startNs_) / NS_PER_SECOND);
+    bool finished = false;
+    if (loop_ && duration_ > 0.0f) {
+        seconds = std::fmod(seconds, duration_);
+    } else if (seconds >= duration_) {
+        // Pose the final keyframes once, then hand the balls back to the simulation.
+        seconds = duration_;
+        finished = true;
+    }
+
+    Seek(seconds);
+    Evaluate(seconds);
+
+    for (int32_t t = 0; t < trackCount_; t++) {
+        Metaball *mb = pool.Get(handles_[t]);
+        if (!mb) {
+            continue;
+        }
+        // prev = current, so render interpolation lands exactly on the keyframed pose.
+        mb->x = mb->prevX = outX_[t];
+        mb->y = mb->prevY = outY_[t];
+        mb->radius = outRadius_[t];
+    }
+    active_ = !finished;
+}
+
+void Timeline::Seek(float seconds)
+{
+    bool rewound = seconds < lastSeconds_;
+    lastSeconds_ = seconds;
+    for (int32_t t = 0; t < trackCount_; t++) {
+        int32_t first = trackStart_[t];
+        int32_t last = trackStart_[t + 1] - 1;
+        int32_t k = rewound ? first : first + cursor_[t];
+        while (k < last && keyTime_[k + 1] <= seconds) {
+            k++;
+        }
+        cursor_[t] = k - first;
+
+        int32_t next = k < last ? k + 1 : k;
+        float span = keyTime_[next] - keyTime_[k];
+        segStart_[t] = keyTime_[k];
+        segInvSpan_[t] = span > 0.0f ? 1.0f / span : 0.0f;
+        segEasing_[t] = keyEasing_[k];
+        segX0_[t] = keyX_[k];
+        segDx_[t] = keyX_[next] - keyX_[k];
+        segY0_[t] = keyY_[k];
+        segDy_[t] = keyY_[next] - keyY_[k];
+        segR0_[t] = keyRadius_[k];
+        segDr_[t] = keyRadius_[next] - keyRadius_[k];
+    }
+}
+
+void Timeline::Evaluate(float seconds)
+{
+    const int32_t n = trackCount_;
+    const float *start = segStart_.data();
+    const float *invSpan = segInvSpan_.data();
+    const float *easing = segEasing_.data();
+    const float *x0 = segX0_.data();
+    const float *dx = segDx_.data();
+    const float *y0 = segY0_.data();
+    const float *dy = segDy_.data();
+    const float *r0 = segR0_.data();
+    const float *dr = segDr_.data();
+    float *outX = outX_.data();
+    float *outY = outY_.data();
+    float *outRadius = outRadius_.data();
+
+    // Straight-line selects only, so this loop vectorizes across tracks.
+    for (int32_t t = 0; t < n; t++) {
+        float u = (seconds - start[t]) * invSpan[t];
+        u = u < 0.0f ? 0.0f : (u > 1.0f ? 1.0f : u);
+        float easeIn = u * u;
+        float easeOut = u * (2.0f - u);
+        float easeInOut = u < 0.5f ? 2.0f * u * u : u * (4.0f - 2.0f * u) - 1.0f;
+        float step = u >= 1.0f ? 1.0f : 0.0f;
+        float e = easing[t];
+        float w = e == 0.0f ? u : (e == 1.0f ? easeIn : (e == 2.0f ? easeOut : (e == 3.0f ? easeInOut : step)));
+        outX[t] = x0[t] + dx[t] * w;
+        outY[t] = y0[t] + dy[t] * w;
+        outRadius[t] = r0[t] + dr[t] * w;
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "render/metaball_pool.h"
+
+// track, time (s), x, y, radius, easing
+#define TIMELINE_KEYFRAME_FLOATS 6
+#define TIMELINE_MAX_KEYFRAMES 8192
+
+// Shape of the segment that starts at a keyframe.
+enum TimelineEasing : uint8_t {
+    EASE_LINEAR = 0,
+    EASE_IN = 1,
+    EASE_OUT = 2,
+    EASE_IN_OUT = 3,
+    // Holds the keyframe's values until the next keyframe.
+    EASE_STEP = 4
+};
+
+/**
+ * Keyframe choreography evaluated natively each frame.
+ * JS uploads every track once; each track drives one ball through
+ * position and radius keyframes. Per frame, a scalar pass moves each
+ * track's segment cursor (amortized O(1), since time only moves forward) and
+ * gathers the active segment into flat arrays; the easing and interpolation
+ * pass then runs branch-free over all tracks at once so the compiler
+ * vectorizes it. Tracks whose ball has been removed are skipped.
+ */
+class Timeline {
+public:
+    // JS thread. keyframes holds TIMELINE_KEYFRAME_FLOATS floats per key; keys of a track must be
+    // in ascending time order. Replaces the running timeline, which restarts on the next frame.
+    bool Load(const MetaballHandle *handles, int32_t trackCount, const float *keyframes, int32_t keyCount,
+              bool loop);
+    void Clear();
+    // Render thread with g_metaballMutex held, after the simulation steps. Poses every bound ball
+    // for the VSync timestamp; balls go back to free motion once a non-looping timeline ends.
+    void Apply(int64_t timestampNs, MetaballPool &pool);
+
+private:
+    void Seek(float seconds);
+    void Evaluate(float seconds);
+
+    std::mutex mutex_;
+    bool active_ = false;
+    bool loop_ = false;
+    float duration_ = 0.0f;
+    int64_t startNs_ = -1;
+    float lastSeconds_ = 0.0f;
+    int32_t trackCount_ = 0;
+    std::vector<MetaballHandle> handles_;
+    std::vector<int32_t> trackStart_;
+    std::vector<int32_t> cursor_;
+
+    // Keyframes, SoA, tracks back to back.
+    std::vector<float> keyTime_;
+    std::vector<float> keyX_;
+    std::vector<float> keyY_;
+    std::vector<float> keyRadius_;
+    std::vector<float> keyEasing_;
+
+    // Active segment per track, refreshed every frame.
+    std::vector<float> segStart_;
+    std::vector<float> segInvSpan_;
+    std::vector<float> segEasing_;
+    std::vector<float> segX0_;
+    std::vector<float> segDx_;
+    std::vector<float> segY0_;
+    std::vector<float> segDy_;
+    std::vector<float> segR0_;
+    std::vector<float> segDr_;
+
+    std::vector<float> outX_;
+    std::vector<float> outY_;
+    std::vector<float> outRadius_;
+};
+
+#endif // TIMELINE_H
@@ -7,8 +7,54 @@ export interface RenderContext {
  * @param context - XComponent context
  * @param x - X coordinate on screen
  * @param y - Y coordinate on screen
+ * @returns Handle of the new metaball, or 0 if the scene is full
  */
-export const addMetaball: (context: ESObject, x: number, y: number) => void;
+export const addMetaball: (context: ESObject, x: number, y: number) => number;
+
+/**
+ * Removes a single metaball
+ * @param context - XComponent context
+ * @param handle - Handle returned by addMetaball
+ * @returns false if the handle is stale or unknown
+ */
+export const removeMetaball: (context: ESObject, handle: number) => boolean;
+
+/**
+ * Moves a single metaball to new screen coordinates
+ * @param context - XComponent context
+ * @param handle - Handle returned by addMetaball
+ * @param x - X coordinate on screen
+ * @param y - Y coordinate on screen
+ * @returns false if the handle is stale or unknown
+ */
+export const moveMetaball: (context: ESObject, handle: number, x: number, y: number) => boolean;
+
+/**
+ * Sets the radius of a single metaball; its field contribution is strength * radius^2 / d^2
+ * @param context - XComponent context
+ * @param handle - Handle returned by addMetaball
+ * @param radius - Radius in pixels, 2 to 120 (default 25)
+ * @returns false if the handle is stale or the radius is out of range
+ */
+export const setMetaballRadius: (context: ESObject, handle: number, radius: number) => boolean;
+
+/**
+ * Scales the field contribution of a single metaball
+ * @param context - XComponent context
+ * @param handle - Handle returned by addMetaball
+ * @param strength - 0 (invisible) to 8 (default 1)
+ * @returns false if the handle is stale or the strength is out of range
+ */
+export const setMetaballStrength: (context: ESObject, handle: number, strength: number) => boolean;
+
+/**
+ * Tints a single metaball; where blobs merge, the tint is their field-weighted mix
+ * @param context - XComponent context
+ * @param handle - Handle returned by addMetaball
+ * @param color - 0xRRGGBB multiplier on the band colors (default 0xFFFFFF, no tint)
+ * @returns false if the handle is stale or the color is out of range
+ */
+export const setMetaballColor: (context: ESObject, handle: number, color: number) => boolean;
 
 /**
  * Clears all metaballs from the scene
@@ -16,4 +62,225 @@ export const addMetaball: (context: ESObject, x: number, y: number) => void;
  */
 export const clearMetaballs: (context: ESObject) => void;
 
+/**
+ * Switches between full per-pixel field evaluation and the incremental mode,
+ * which keeps the exact field in a float texture and only redraws balls that moved.
+ * Each moved ball costs a full-screen pass, so frames where more than a quarter of
+ * the balls moved are still evaluated directly. The free simulation moves every ball
+ * every frame, so this only pays off when timeline tracks hold most balls in place.
+ * Same image either way.
+ * Ignored when the GPU lacks a blendable 32-bit float render target.
+ * @param context - XComponent context
+ * @param enabled - true for incremental updates
+ */
+export const setIncrementalField: (context: ESObject, enabled: boolean) => void;
+
+/**
+ * Moves the simulation onto the GPU: ball state stays in GPU buffers, each frame's steps
+ * run in one transform-feedback pass, and the field shader reads the centers from there,
+ * so no per-ball data is uploaded per frame. Adds, removes and moves are sent as small
+ * buffer updates. While it is on, hitTest/sampleField and events trail the screen by a
+ * frame or two. Attraction, timelines, block culling and the incremental field are
+ * paused, because they work on the CPU-side positions. Not available with the software
+ * renderer. Off by default.
+ * @param context - XComponent context
+ * @param enabled - true to simulate on the GPU
+ */
+export const setGpuSimulation: (context: ESObject, enabled: boolean) => void;
+
+/**
+ * Sets the field values where the outer band and the blob core begin.
+ * Applies to rendering, sampleField bands and hitTest.
+ * @param context - XComponent context
+ * @param halo - Start of the outer band (default 0.5, minimum 0.1)
+ * @param inside - Start of the core (default 1.0, maximum 4.0); must be greater than halo
+ * @returns false if the levels were rejected
+ */
+export const setIsoLevels: (context: ESObject, halo: number, inside: number) => boolean;
+
+/**
+ * Blends each isoline over one pixel, using the field's screen-space gradient, instead of
+ * a hard step. On by default; costs about the same as the hard-edged shading.
+ * The CPU fallback renderer always draws hard edges.
+ * @param context - XComponent context
+ * @param enabled - false for the original hard thresholds
+ */
+export const setEdgeAntialiasing: (context: ESObject, enabled: boolean) => void;
+
+/**
+ * Skips the per-pixel field loop for 16x16 blocks that provably lie inside a single band
+ * and fills them with that band's color instead. On by default; the image is unchanged.
+ * @param context - XComponent context
+ * @param enabled - false to evaluate the field at every pixel
+ */
+export const setBlockCulling: (context: ESObject, enabled: boolean) => void;
+
+/**
+ * Makes the balls pull on each other: every simulation step bends each ball's heading
+ * toward the combined pull of the others, while its speed stays the same. Mass is the
+ * ball's field weight, strength * radius^2, so a strength-0 ball pulls on nothing but is
+ * still pulled. The pull falls off with the square of distance (softened by the default
+ * radius). Forces come from a Barnes-Hut quadtree, so the cost grows as n log n; below
+ * the ball count where the tree pays off at the chosen theta, the exact sum is used.
+ * @param context - XComponent context
+ * @param strength - Gravitational constant in px^3/s^2; 0 (the default) turns attraction
+ *   off, around 1e6 gives a gentle pull, at most 1e8
+ * @param theta - Opening angle, 0 to 2 (default 0.5); 0 computes the exact sum, larger is
+ *   faster and coarser
+ * @returns false if either value was rejected
+ */
+export const setAttraction: (context: ESObject, strength: number, theta: number) => boolean;
+
+/**
+ * Chooses the window surface's color format. The field output is opaque and two-toned, so
+ * RGB565 halves the memory and display bandwidth of RGBA8888 at the cost of slightly banded
+ * edges. If the device has no matching config, MSAA is dropped first, then the format is
+ * widened (565 -> 888 -> 8888); getSurfaceFormat reports what was granted.
+ * Read when the surface is created: call it from onLoad, or it applies to the next surface.
+ * @param context - XComponent context
+ * @param profile - 0 RGBA8888, 1 RGB888 (the default), 2 RGB565
+ * @param srgb - Tag the surface sRGB (the default). Colors look the same either way: a
+ *   linear surface, and any 565 surface, gets the sRGB curve applied in the shader
+ * @param samples - MSAA samples per pixel, 0 for none (the default), at most 16
+ * @returns false if the profile or sample count was rejected
+ */
+export const setSurfaceFormat: (context: ESObject, profile: number, srgb: boolean, samples: number) => boolean;
+
+/**
+ * The color format the current window surface was created with.
+ */
+export interface SurfaceFormat {
+  red: number;
+  green: number;
+  blue: number;
+  alpha: number;
+  samples: number;
+  /** True if the surface converts to sRGB itself; false if the shader encodes */
+  srgb: boolean;
+  /** 0 if the request was met as given, higher the further it had to fall back */
+  fallbackStep: number;
+  /** Estimated color memory traffic per frame: rendering, MSAA resolve and display read */
+  bytesPerFrame: number;
+}
+
+/**
+ * Reports the chosen surface format; RGBA8888 sRGB under the software renderer.
+ * @param context - XComponent context
+ */
+export const getSurfaceFormat: (context: ESObject) => SurfaceFormat | undefined;
+
+/**
+ * Uploads keyframe tracks that the native render loop plays from the VSync clock,
+ * with no further JS calls while they run. Track i drives the ball handles[i].
+ * Each keyframe is 6 floats: track index, time in seconds, x, y, radius (2 to 120), easing of the
+ * segment that starts at this key (0 linear, 1 ease-in, 2 ease-out, 3 ease-in-out, 4 step).
+ * Keys of one track must be in ascending time order; tracks may be interleaved.
+ * Replaces any running timeline and starts on the next frame. When a non-looping timeline
+ * ends, its balls resume free motion from their last pose.
+ * @param context - XComponent context
+ * @param handles - Ball handles from addMetaball, one per track
+ * @param keyframes - Packed keyframes, at most 8192
+ * @param loop - Restart from 0 s after the last keyframe
+ * @returns false if the tracks were rejected
+ */
+export const setTimeline: (context: ESObject, handles: Uint32Array, keyframes: Float32Array, loop: boolean) => boolean;
+
+/**
+ * Stops the running timeline; its balls resume free motion from where they are.
+ * @param context - XComponent context
+ */
+export const clearTimeline: (context: ESObject) => void;
+
+/**
+ * Writes the current scene (balls, handles and RNG state) to a binary snapshot.
+ * The file is replaced atomically.
+ * @param context - XComponent context
+ * @param path - Absolute path, e.g. `${filesDir}/scene.bin`
+ * @returns false if the file could not be written
+ */
+export const saveScene: (context: ESObject, path: string) => boolean;
+
+/**
+ * Replaces the current scene with a snapshot written by saveScene.
+ * Handles returned before the save are valid again afterwards.
+ * @param context - XComponent context
+ * @param path - Absolute path of the snapshot
+ * @returns false if the file is missing, corrupt or written by an incompatible build;
+ *          the current scene is then left untouched
+ */
+export const loadScene: (context: ESObject, path: string) => boolean;
+
+/**
+ * Evaluates the metaball field at a screen point on the CPU, without a GPU readback.
+ * @param context - XComponent context
+ * @param x - X coordinate on screen
+ * @param y - Y coordinate on screen
+ * @returns Field value; by default >= 0.5 is the outer band, >= 1.0 is the blob core (see setIsoLevels)
+ */
+export const sampleField: (context: ESObject, x: number, y: number) => number;
+
+/**
+ * Classifies a batch of screen points against the blob.
+ * @param context - XComponent context
+ * @param points - Interleaved coordinates [x0, y0, x1, y1, ...]
+ * @returns One entry per point: 0 outside, 1 outer band, 2 inside the core
+ */
+export const hitTest: (context: ESObject, points: Float32Array) => Uint8Array;
+
+/**
+ * Renders the scene offscreen at the requested size and reads it back asynchronously.
+ * The on-screen frame is not delayed; the callback runs a few frames later.
+ * @param context - XComponent context
+ * @param width - Capture width in pixels (1..2048)
+ * @param height - Capture height in pixels (1..2048)
+ * @param callback - Receives top-down RGBA8888 pixels; called exactly once per accepted request,
+ *   with null pixels if the capture could not finish (e.g. the surface was destroyed first)
+ * @returns false if the request was rejected (bad size, too many pending, or no GPU)
+ */
+export const captureScene: (context: ESObject, width: number, height: number,
+  callback: (pixels: ArrayBuffer | null, width: number, height: number) => void) => boolean;
+
+/**
+ * Native state changes merged since the previous batch. Only fields of the types
+ * set in `types` are present.
+ * Event types (bit flags): 1 ball count, 2 capacity reached, 4 frame stats, 8 surface lifecycle.
+ */
+export interface RenderEventBatch {
+  types: number;
+  ballCount?: number;
+  /** addMetaball calls rejected because the pool was full */
+  capacityRejections?: number;
+  frames?: number;
+  simSteps?: number;
+  avgFrameIntervalMs?: number;
+  maxFrameIntervalMs?: number;
+  /** Render-thread CPU time per frame */
+  avgCpuMs?: number;
+  /** 1 created, 2 changed, 3 destroyed; the latest state wins */
+  surfaceState?: number;
+  surfaceWidth?: number;
+  surfaceHeight?: number;
+  /** True if a surface was destroyed since the previous batch, even if surfaceState already reports its successor */
+  surfaceDestroyed?: boolean;
+}
+
+/**
+ * Subscribes to native renderer events. Events are merged per frame and delivered in
+ * batches on the JS thread; while a batch is waiting, newer events fold into the next one.
+ * Surface changes are not held back by a waiting batch and may arrive in a batch of their own.
+ * @param context - XComponent context
+ * @param mask - OR of the wanted event types (15 for all)
+ * @param callback - Receives one RenderEventBatch per delivery
+ * @returns Subscription id, or 0 if all 8 subscriber slots are taken
+ */
+export const subscribeEvents: (context: ESObject, mask: number, callback: (batch: RenderEventBatch) => void) => number;
+
+/**
+ * Ends a subscription made with subscribeEvents. A batch already queued is still delivered.
+ * @param context - XComponent context
+ * @param subscription - Id returned by subscribeEvents
+ * @returns false if the id is unknown
+ */
+export const unsubscribeEvents: (context: ESObject, subscription: number) => boolean;
+
 export const getContext: (value: number) => ESObject;